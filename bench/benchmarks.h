@@ -0,0 +1,22 @@
+// Benchmark modes of pathfinder_bench. Each takes the command line with the mode
+// name in argv[1] and its own arguments from argv[2] on, prints a report and
+// returns the exit status.
+
+#ifndef PATHFINDER_BENCHMARKS_H
+#define PATHFINDER_BENCHMARKS_H
+
+#include "pathfinder_internal.h"
+
+int orderBenchMain(int argc, char* argv[]);        // --order-bench
+int overlayBenchMain(int argc, char* argv[]);      // --overlay-bench
+int progressiveBenchMain(int argc, char* argv[]);  // --progressive-bench
+int pathBenchMain(int argc, char* argv[]);         // --path-bench
+
+// Bounds of the numeric arguments, so a typo cannot ask for a huge allocation
+const int MAX_GRID_SIDE = 4096;          // 16M nodes
+const int MAX_BENCH_QUERIES = 1000000;   // Queries, changed arcs or rounds
+
+// Random side x side grid with shuffled node numbers (see synthetic_grid.cpp)
+Graph syntheticGrid(int side, unsigned seed);
+
+#endif
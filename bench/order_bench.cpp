@@ -0,0 +1,152 @@
+// pathfinder_bench --order-bench: A* query time and hardware cache misses for each
+// node order, on a campus profile and on a synthetic grid
+
+#include "benchmarks.h"
+
+#include "pathfinder_internal.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+enum CounterEvent { COUNT_LLC_MISSES, COUNT_L1D_READ_MISSES };
+
+// Hardware event counter for the calling thread (Linux perf_event_open).
+// valid is false when the kernel or sandbox does not allow it.
+class PerfCounter {
+public:
+    int fd;
+    bool valid;
+
+    PerfCounter(CounterEvent event) : fd(-1), valid(false) {
+#ifdef __linux__
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        if (event == COUNT_LLC_MISSES) {
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        } else {
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        }
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        valid = fd >= 0;
+#endif
+    }
+
+    ~PerfCounter() {
+#ifdef __linux__
+        if (valid)
+            close(fd);
+#endif
+    }
+
+    void start() {
+#ifdef __linux__
+        if (valid) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Events counted since start(), -1 if unavailable
+    long long stop() {
+#ifdef __linux__
+        long long count;
+        if (valid) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd, &count, sizeof(count)) == sizeof(count))
+                return count;
+        }
+#endif
+        return -1;
+    }
+};
+
+// Time `queries` random A* queries (same pairs for every order) on a copy of the
+// graph renumbered with each order, and print time and cache misses per query
+void benchNodeOrders(const std::string& title, const Graph& base, int queries) {
+    const char* orders[] = {"none", "bfs", "rcm", "hilbert"};
+    PerfCounter llcMisses(COUNT_LLC_MISSES);
+    PerfCounter l1Misses(COUNT_L1D_READ_MISSES);
+
+    // Query endpoints in public node numbers, drawn from nodes that have arcs
+    Graph probe = base;
+    probe.finalize();
+    std::vector<int> nodes;
+    for (int v = 0; v < probe.numNodes; ++v) {
+        if (probe.hasArcs(v))
+            nodes.push_back(probe.extId[v]);
+    }
+    std::vector<std::pair<int, int>> pairs;
+    std::mt19937 rng(7);
+    for (int i = 0; i < queries; ++i)
+        pairs.push_back(std::make_pair(nodes[rng() % nodes.size()], nodes[rng() % nodes.size()]));
+
+    std::cout << title << " (" << base.numNodes << " nodes, " << queries << " queries)" << std::endl;
+    std::cout << "order\tus/query\tcache-misses/query\tL1d-misses/query" << std::endl;
+    for (const char* order : orders) {
+        Graph graph = base;
+        applyNodeOrder(graph, order);
+        std::vector<int> parent;
+        long long checksum = 0;
+
+        llcMisses.start();
+        l1Misses.start();
+        auto begin = std::chrono::steady_clock::now();
+        for (auto& p : pairs)
+            checksum += aStarSearch(graph, graph.intId[p.first], graph.intId[p.second], parent);
+        auto end = std::chrono::steady_clock::now();
+        long long llc = llcMisses.stop();
+        long long l1 = l1Misses.stop();
+
+        double us = std::chrono::duration<double, std::micro>(end - begin).count() / queries;
+        std::cout << order << "\t" << us;
+        std::cout << "\t" << (llc < 0 ? std::string("n/a") : std::to_string(llc / queries));
+        std::cout << "\t" << (l1 < 0 ? std::string("n/a") : std::to_string(l1 / queries));
+        std::cout << "\t(checksum " << checksum << ")" << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// --order-bench <type> <time> <weather> [queries] [grid_side]
+int orderBenchMain(int argc, char* argv[]) {
+    if (argc < 5) {
+        std::cerr << "Usage: " << argv[0] << " --order-bench <type> <time> <weather> [queries] [grid_side]" << std::endl;
+        return 1;
+    }
+    int type, weather, queries = 2000, side = 128;
+    if (!parseIntArg(argv[2], type) || !parseIntArg(argv[4], weather) ||
+        (argc > 5 && !parseIntArg(argv[5], queries, 1, MAX_BENCH_QUERIES)) ||
+        (argc > 6 && !parseIntArg(argv[6], side, 2, MAX_GRID_SIDE))) {
+        std::cerr << "Usage: " << argv[0] << " --order-bench <type> <time> <weather> [queries] [grid_side]" << std::endl;
+        std::cerr << "queries 1-" << MAX_BENCH_QUERIES << ", grid_side 2-" << MAX_GRID_SIDE << std::endl;
+        return 1;
+    }
+
+    Graph campus(CAMPUS_NODES);
+    if (!loadCampusGraph(campus, campusProfile(type, weather), "none")) {
+        return 0;
+    }
+    benchNodeOrders("Campus profile", campus, queries);
+    benchNodeOrders("Synthetic grid", syntheticGrid(side, 1), std::max(1, queries / 20));
+    return 0;
+}
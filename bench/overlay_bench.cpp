@@ -0,0 +1,138 @@
+// pathfinder_bench --overlay-bench: partitioning, customization and queries of the
+// multi-level overlay on a synthetic grid, checked against A*
+
+#include "benchmarks.h"
+
+#include "pathfinder_internal.h"
+
+#include <chrono>
+#include <climits>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Compare overlay queries with A* on the full graph, avoiding the same features, for
+// the given pairs; returns the number of disagreements (distance, or an unpacked
+// path of another cost or over an arc with an avoided feature)
+int checkOverlayQueries(Graph& graph, MultiLevelOverlay& overlay, const std::vector<std::pair<int, int>>& pairs,
+                        double& overlayMs, double& aStarMs) {
+    OverlayWorkspace ws(graph.numNodes);
+    std::vector<int> overlayDist(pairs.size()), parent, path;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < pairs.size(); ++i)
+        overlayDist[i] = overlay.route(pairs[i].first, pairs[i].second, ws);
+    overlayMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    int mismatches = 0;
+    SearchControl control;
+    control.avoid = overlay.avoid;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        if (aStarSearch(graph, pairs[i].first, pairs[i].second, parent, 0, &control) != overlayDist[i])
+            mismatches++;
+    }
+    aStarMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    for (size_t i = 0; i < pairs.size() && i < 20; ++i) {
+        int distance = overlay.route(pairs[i].first, pairs[i].second, ws, &path);
+        if (distance == INT_MAX)
+            continue;
+        long long cost = 0;
+        for (size_t k = 1; k < path.size(); ++k)
+            cost += graph.arcCost(path[k - 1], path[k], overlay.avoid);
+        if (path.back() != pairs[i].second || cost != distance)
+            mismatches++;
+    }
+    return mismatches;
+}
+
+// --overlay-bench [grid_side] [queries] [changed_arcs]
+// Partition and customize an overlay of a synthetic grid, compare its queries with
+// A*, then change random arc weights and re-customize only the affected cells
+int overlayBenchMain(int argc, char* argv[]) {
+    int side = 512, queries = 200, changes = 100;
+    if ((argc > 2 && !parseIntArg(argv[2], side, 2, MAX_GRID_SIDE)) ||
+        (argc > 3 && !parseIntArg(argv[3], queries, 1, MAX_BENCH_QUERIES)) ||
+        (argc > 4 && !parseIntArg(argv[4], changes, 0, MAX_BENCH_QUERIES))) {
+        std::cerr << "Usage: " << argv[0] << " --overlay-bench [grid_side] [queries] [changed_arcs]" << std::endl;
+        std::cerr << "grid_side 2-" << MAX_GRID_SIDE << ", queries 1-" << MAX_BENCH_QUERIES << ", changed_arcs 0-"
+                  << MAX_BENCH_QUERIES << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Graph graph = syntheticGrid(side, 1);
+    graph.finalize();
+    auto elapsed = [&]() {
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        return ms;
+    };
+    std::cout << "Grid " << side << "x" << side << ": " << graph.numNodes << " nodes, " << graph.head.size()
+              << " arcs, built in " << elapsed() << " ms" << std::endl;
+
+    MultiLevelOverlay overlay(graph, {256, 4096, 65536});
+    double partitionMs = elapsed();
+    overlay.customize();
+    double customizeMs = elapsed();
+    std::cout << "Partition: " << partitionMs << " ms, customization: " << customizeMs << " ms, overlay memory: "
+              << overlay.memoryBytes() / (1024.0 * 1024.0) << " MiB" << std::endl;
+    for (size_t l = 0; l < overlay.levels.size(); ++l) {
+        size_t boundary = 0, cliqueArcs = 0;
+        for (const OverlayCell& cell : overlay.levels[l].cells) {
+            boundary += cell.entries.size();
+            cliqueArcs += cell.clique.size();
+        }
+        std::cout << "  level " << l << ": " << overlay.levels[l].cells.size() << " cells of " << overlay.levels[l].cellSize
+                  << " nodes, " << boundary << " entry points, " << cliqueArcs << " clique arcs" << std::endl;
+    }
+
+    std::mt19937 rng(7);
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < queries; ++i)
+        pairs.push_back(std::make_pair(rng() % graph.numNodes, rng() % graph.numNodes));
+    double overlayMs, aStarMs;
+    int mismatches = checkOverlayQueries(graph, overlay, pairs, overlayMs, aStarMs);
+    std::cout << "Queries: overlay " << overlayMs * 1000 / queries << " us, A* " << aStarMs * 1000 / queries
+              << " us per query, " << mismatches << " mismatches" << std::endl;
+
+    std::vector<std::pair<int, int>> changed;
+    for (int i = 0; i < changes; ++i) {
+        int u = rng() % graph.numNodes;
+        int degree = graph.firstOut[u + 1] - graph.firstOut[u];
+        if (degree == 0)
+            continue;
+        int v = graph.head[graph.firstOut[u] + rng() % degree];
+        graph.setArcWeight(u, v, 1 + rng() % 200);
+        changed.push_back(std::make_pair(u, v));
+    }
+    graph.finalize();
+    elapsed();
+    overlay.customizeChanged(changed);
+    double recustomizeMs = elapsed();
+    mismatches = checkOverlayQueries(graph, overlay, pairs, overlayMs, aStarMs);
+    std::cout << "Changed " << changed.size() << " arcs: re-customization " << recustomizeMs << " ms, "
+              << mismatches << " mismatches afterwards" << std::endl;
+
+    // Stairs on about 5% of the edges, then a step-free overlay on the same partition
+    int stairs = 0;
+    for (int u = 0; u < graph.numNodes; ++u) {
+        int degree = graph.firstOut[u + 1] - graph.firstOut[u];
+        if (degree == 0 || rng() % 20 != 0)
+            continue;
+        int v = graph.head[graph.firstOut[u] + rng() % degree];
+        graph.setArcAccess(u, v, ACCESS_STAIRS);
+        graph.setArcAccess(v, u, ACCESS_STAIRS);
+        stairs++;
+    }
+    MultiLevelOverlay stepFree = overlay;
+    elapsed();
+    stepFree.customizeAvoiding(ACCESS_STAIRS);
+    double stepFreeMs = elapsed();
+    mismatches = checkOverlayQueries(graph, stepFree, pairs, overlayMs, aStarMs);
+    std::cout << "Step-free (" << stairs << " edges with stairs): customization " << stepFreeMs << " ms, overlay "
+              << overlayMs * 1000 / queries << " us, A* " << aStarMs * 1000 / queries << " us per query, "
+              << mismatches << " mismatches" << std::endl;
+    return 0;
+}
@@ -0,0 +1,82 @@
+// pathfinder_bench --path-bench: memory and decode time of PackedRoutes
+
+#include "benchmarks.h"
+
+#include "pathfinder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// --path-bench [rounds]
+// Route every pair of campus nodes on every profile, as a bulk precomputation
+// would, and compare keeping the routes as RouteResults with PackedRoutes: the
+// memory of each, and the time to decode a packed route against copying one.
+// Every decoded route is checked against the original.
+int pathBenchMain(int argc, char* argv[]) {
+    int rounds = 20;
+    if (argc > 2 && !parseIntArg(argv[2], rounds, 1, MAX_BENCH_QUERIES)) {
+        std::cerr << "Usage: " << argv[0] << " --path-bench [rounds]" << std::endl;
+        std::cerr << "rounds 1-" << MAX_BENCH_QUERIES << std::endl;
+        return 1;
+    }
+
+    std::shared_ptr<const Router> router = Router::load(RouterOptions());
+    std::vector<int> targets(router->nodeCount());
+    for (int v = 0; v < router->nodeCount(); ++v)
+        targets[v] = v;
+    std::vector<RouteResult> routes, batch;
+    for (int p = 0; p < NUM_CAMPUS_PROFILES; ++p) {
+        for (int source = 0; source < router->nodeCount(); ++source) {
+            router->routeMany(source, targets, p, 9 * 3600, batch);
+            routes.insert(routes.end(), batch.begin(), batch.end());
+        }
+    }
+
+    PackedRoutes packed;
+    size_t nodes = 0, plainBytes = 0;
+    for (const RouteResult& route : routes) {
+        packed.add(route);
+        nodes += route.path.size();
+        plainBytes += sizeof(RouteResult) + route.path.capacity() * sizeof(int);
+    }
+    packed.shrink();
+    std::cout << "Stored " << routes.size() << " campus routes of " << nodes << " nodes: RouteResult "
+              << plainBytes / 1024.0 << " KiB, packed " << packed.memoryBytes() / 1024.0 << " KiB ("
+              << (double)packed.memoryBytes() / nodes << " bytes per node)" << std::endl;
+
+    // Both loops read each route into one reused result, so neither allocates
+    RouteResult out;
+    unsigned long long decodedNodes = 0, copiedNodes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < packed.size(); ++i) {
+            packed.get(i, out);
+            decodedNodes += out.path.size();
+        }
+    }
+    double decodeNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const RouteResult& route : routes) {
+            out = route;
+            copiedNodes += out.path.size();
+        }
+    }
+    double copyNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    int mismatches = decodedNodes != copiedNodes;
+    for (int i = 0; i < packed.size(); ++i) {
+        const RouteResult& route = routes[i];
+        if (!packed.get(i, out) || out.found != route.found || out.optimal != route.optimal ||
+            out.exhausted != route.exhausted || out.distance != route.distance || out.path != route.path)
+            mismatches++;
+    }
+    double lookups = (double)routes.size() * rounds;
+    std::cout << "Decode: " << decodeNs / lookups << " ns per route (" << decodeNs / (nodes * (double)rounds)
+              << " ns per node), copy: " << copyNs / lookups << " ns per route, " << mismatches << " mismatches" << std::endl;
+    return 0;
+}
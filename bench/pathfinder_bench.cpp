@@ -0,0 +1,41 @@
+// Benchmarks of the engine library.
+//   pathfinder_bench [queries_file|query_log] [rounds] [speed] [threads]
+// replays a recorded query workload or query log through the Router and reports
+// throughput and latency. Without arguments it replays bench/campus_queries.txt
+// from the source tree. See replayMain in pathfinder.cpp for the options.
+//   pathfinder_bench --order-bench <type> <time> <weather> [queries] [grid_side]
+// times A* and counts cache misses for each node order.
+//   pathfinder_bench --overlay-bench [grid_side] [queries] [changed_arcs]
+// builds, customizes and queries a multi-level overlay of a synthetic grid.
+//   pathfinder_bench --progressive-bench [grid_side] [queries] [suboptimality]
+// times both phases of progressive queries and their cancellation.
+//   pathfinder_bench --path-bench [rounds]
+// compares the memory and decode time of PackedRoutes with plain RouteResults.
+
+#include "benchmarks.h"
+
+#include "pathfinder.h"
+
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    std::string mode = argc > 1 ? argv[1] : "";
+    if (mode == "--order-bench")
+        return orderBenchMain(argc, argv);
+    if (mode == "--overlay-bench")
+        return overlayBenchMain(argc, argv);
+    if (mode == "--progressive-bench")
+        return progressiveBenchMain(argc, argv);
+    if (mode == "--path-bench")
+        return pathBenchMain(argc, argv);
+
+    std::vector<std::string> args = { argv[0], "--replay", argc > 1 ? argv[1] : PATHFINDER_DEFAULT_WORKLOAD };
+    for (int i = 2; i < argc; ++i)
+        args.push_back(argv[i]);
+    std::vector<char*> pointers;
+    for (std::string& arg : args)
+        pointers.push_back(&arg[0]);
+    pointers.push_back(nullptr);
+    return pathfinderMain((int)args.size(), pointers.data());
+}
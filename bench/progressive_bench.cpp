@@ -0,0 +1,98 @@
+// pathfinder_bench --progressive-bench: both phases of a progressive query and
+// cancellation, on a synthetic grid
+
+#include "benchmarks.h"
+
+#include "pathfinder_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// --progressive-bench [grid_side] [queries] [suboptimality]
+// Time the two phases of a progressive query on a synthetic grid: weighted A* for
+// the first route, then A* bounded by its cost for the optimal one. The optimal
+// costs are checked against plain A*, and a few bounded searches are cancelled
+// from another thread to time how quickly they stop.
+int progressiveBenchMain(int argc, char* argv[]) {
+    int side = 512, queries = 100;
+    double suboptimality = 1.5;
+    if ((argc > 2 && !parseIntArg(argv[2], side, 2, MAX_GRID_SIDE)) ||
+        (argc > 3 && !parseIntArg(argv[3], queries, 1, MAX_BENCH_QUERIES)) ||
+        (argc > 4 && !parseDoubleArg(argv[4], suboptimality, 1, 10))) {
+        std::cerr << "Usage: " << argv[0] << " --progressive-bench [grid_side] [queries] [suboptimality]" << std::endl;
+        std::cerr << "grid_side 2-" << MAX_GRID_SIDE << ", queries 1-" << MAX_BENCH_QUERIES << ", suboptimality 1-10"
+                  << std::endl;
+        return 1;
+    }
+
+    Graph graph = syntheticGrid(side, 1);
+    graph.finalize();
+    std::mt19937 rng(7);
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < queries; ++i)
+        pairs.push_back(std::make_pair(rng() % graph.numNodes, rng() % graph.numNodes));
+
+    std::vector<int> parent;
+    double firstMs = 0, optimalMs = 0, plainMs = 0, excess = 0;
+    int routes = 0, mismatches = 0;
+    for (auto& q : pairs) {
+        auto start = std::chrono::steady_clock::now();
+        SearchControl quick;
+        quick.heuristicPercent = std::max(100, (int)std::lround(suboptimality * 100));
+        int early = aStarSearch(graph, q.first, q.second, parent, 0, &quick);
+        auto first = std::chrono::steady_clock::now();
+        SearchControl exact;
+        exact.upperBound = early;
+        int best = aStarSearch(graph, q.first, q.second, parent, 0, &exact);
+        auto done = std::chrono::steady_clock::now();
+        int reference = aStarSearch(graph, q.first, q.second, parent);
+        auto end = std::chrono::steady_clock::now();
+
+        firstMs += std::chrono::duration<double, std::milli>(first - start).count();
+        optimalMs += std::chrono::duration<double, std::milli>(done - start).count();
+        plainMs += std::chrono::duration<double, std::milli>(end - done).count();
+        if (best != reference)
+            mismatches++;
+        if (reference != INT_MAX && reference > 0) {
+            excess += (double)early / reference - 1;
+            routes++;
+        }
+    }
+    std::cout << "Grid " << side << "x" << side << ", " << queries << " queries, suboptimality " << suboptimality << std::endl;
+    std::cout << "First route: " << firstMs * 1000 / queries << " us, optimal route: " << optimalMs * 1000 / queries
+              << " us, plain A*: " << plainMs * 1000 / queries << " us per query" << std::endl;
+    std::cout << "First routes cost " << (routes ? excess * 100 / routes : 0) << "% more than the optimum on average, "
+              << mismatches << " mismatches" << std::endl;
+
+    // Cancel bounded searches halfway through a plain one's running time
+    int cancelled = 0, trials = std::min(queries, 20);
+    double stopMs = 0;
+    for (int i = 0; i < trials; ++i) {
+        std::atomic<bool> cancel(false);
+        SearchControl control;
+        control.cancel = &cancel;
+        std::vector<int> searchParent;
+        auto begin = std::chrono::steady_clock::now();
+        std::thread search([&]() { aStarSearch(graph, pairs[i].first, pairs[i].second, searchParent, 0, &control); });
+        std::this_thread::sleep_for(std::chrono::microseconds((long long)(plainMs * 500 / queries)));
+        auto raised = std::chrono::steady_clock::now();
+        cancel.store(true, std::memory_order_relaxed);
+        search.join();
+        if (control.stopped) {
+            cancelled++;
+            stopMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - std::max(raised, begin)).count();
+        }
+    }
+    std::cout << "Cancellation: " << cancelled << " of " << trials << " searches stopped, "
+              << (cancelled ? stopMs * 1000 / cancelled : 0) << " us after the flag on average" << std::endl;
+    return 0;
+}
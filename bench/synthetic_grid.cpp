@@ -0,0 +1,34 @@
+// Synthetic grid graphs for the benchmarks that need more nodes than the campus
+
+#include "benchmarks.h"
+
+#include "pathfinder_internal.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// side x side grid with random weights and shuffled node numbers, standing in for
+// a large hand-surveyed map where neighbours are scattered across the id space
+Graph syntheticGrid(int side, unsigned seed) {
+    int n = side * side;
+    std::mt19937 rng(seed);
+    std::vector<int> id(n);
+    for (int i = 0; i < n; ++i)
+        id[i] = i;
+    std::shuffle(id.begin(), id.end(), rng);
+
+    Graph graph(n);
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            int u = id[r * side + c];
+            graph.setPosition(u, c, r);
+            if (c + 1 < side)
+                graph.addEdge(u, id[r * side + c + 1], 1 + rng() % 50);
+            if (r + 1 < side)
+                graph.addEdge(u, id[(r + 1) * side + c], 1 + rng() % 50);
+        }
+    }
+    graph.finalize();
+    return graph;
+}
@@ -1,1088 +1,3577 @@
-#include <iostream>
-#include <vector>
-#include <climits>
-#include <string>
-#include <sstream>
-
-using namespace std;
-
-// ... (include all the classes and functions from the original code)
-class ListNode {
-public:
-    int vertex;
-    int weight;
-    ListNode* next;
-
-    ListNode(int v, int w) : vertex(v), weight(w), next(nullptr) {}
-};
-
-// MinHeapNode class for storing node and f-cost
-class MinHeapNode {
-public:
-    int v;
-    int f;
-    MinHeapNode(int vertex, int cost) : v(vertex), f(cost) {}
-};
-
-// Custom MinHeap class
-class MinHeap {
-public:
-    vector<MinHeapNode> heap;
-
-    int parent(int i) { return (i - 1) / 2; }
-    int left(int i) { return 2 * i + 1; }
-    int right(int i) { return 2 * i + 2; }
-
-    void insert(MinHeapNode node) {
-        heap.push_back(node);
-        int i = heap.size() - 1;
-
-        while (i != 0 && heap[parent(i)].f > heap[i].f) {
-            swap(heap[i], heap[parent(i)]);
-            i = parent(i);
-        }
-    }
-
-    void heapify(int i) {
-        int l = left(i);
-        int r = right(i);
-        int smallest = i;
-
-        if (l < heap.size() && heap[l].f < heap[smallest].f)
-            smallest = l;
-        if (r < heap.size() && heap[r].f < heap[smallest].f)
-            smallest = r;
-
-        if (smallest != i) {
-            swap(heap[i], heap[smallest]);
-            heapify(smallest);
-        }
-    }
-
-    MinHeapNode extractMin() {
-        if (heap.size() == 1) {
-            MinHeapNode root = heap[0];
-            heap.pop_back();
-            return root;
-        }
-
-        MinHeapNode root = heap[0];
-        heap[0] = heap.back();
-        heap.pop_back();
-
-        heapify(0);
-        return root;
-    }
-
-    bool isEmpty() {
-        return heap.empty();
-    }
-};
-
-// Graph class with an adjacency list represented by an array of linked lists
-class Graph {
-public:
-    int numNodes;
-    vector<ListNode*> adjList;
-
-    Graph(int n) {
-        numNodes = n;
-        adjList.resize(n, nullptr);
-    }
-
-    // Add edge to the graph using linked lists
-    void addEdge(int u, int v, int weight) {
-        ListNode* newNode = new ListNode(v, weight);
-        newNode->next = adjList[u];
-        adjList[u] = newNode;
-
-        // Since it's undirected, add the reverse edge as well
-        newNode = new ListNode(u, weight);
-        newNode->next = adjList[v];
-        adjList[v] = newNode;
-    }
-
-    // Utility to print the adjacency list (for debugging)
-    void printGraph() {
-        for (int i = 0; i < numNodes; ++i) {
-            cout << "Node " << i << ": ";
-            ListNode* temp = adjList[i];
-            while (temp) {
-                cout << "(" << temp->vertex << ", " << temp->weight << ") -> ";
-                temp = temp->next;
-            }
-            cout << "NULL\n";
-        }
-    }
-};
-
-// Heuristic function (placeholder)
-int heuristic(int node1, int node2) {
-    return abs(node1 - node2);
-}
-
-// Print the path from source to target
-void printPath(vector<int>& parent, int j) {
-    if (parent[j] == -1) {
-        cout << j << " ";
-        return;
-    }
-    printPath(parent, parent[j]);
-    cout << "-> " << j << " ";
-}
-
-// A* algorithm using custom min-heap and adjacency list as linked lists
-void aStar(Graph& graph, int src, int target) {
-    int numNodes = graph.numNodes;
-    vector<int> g(numNodes, INT_MAX);  // Cost from start to a node
-    vector<int> f(numNodes, INT_MAX);  // Estimated total cost (f = g + h)
-    vector<int> parent(numNodes, -1);  // To store the path
-    MinHeap minHeap;
-
-    g[src] = 0;
-    f[src] = heuristic(src, target);
-    minHeap.insert(MinHeapNode(src, f[src]));
-
-    while (!minHeap.isEmpty()) {
-        int u = minHeap.extractMin().v;
-
-        if (u == target) {
-            cout << "Shortest path found. Distance from source to target: " << g[u] << endl;
-            cout << "Path: ";
-            printPath(parent, u);
-            cout << endl;
-            return;
-        }
-
-        ListNode* neighbor = graph.adjList[u];
-        while (neighbor != nullptr) {
-            int v = neighbor->vertex;
-            int weight = neighbor->weight;
-
-            if (g[u] + weight < g[v]) {
-                g[v] = g[u] + weight;
-                f[v] = g[v] + heuristic(v, target);
-                parent[v] = u;
-                minHeap.insert(MinHeapNode(v, f[v]));
-            }
-
-            neighbor = neighbor->next;
-        }
-    }
-
-    cout << "No path found from source to target." << endl;
-}
-
-int main(int argc, char* argv[]) {
-    if (argc != 6) {
-        std::cerr << "Usage: " << argv[0] << " <source_node> <target_node> <type> <time> <weather>" << std::endl;
-        return 1;
-    }
-
-    int sourceNode = std::stoi(argv[1]);
-    int targetNode = std::stoi(argv[2]);
-    int typeNode = std::stoi(argv[3]);
-    int time_type=std::stoi(argv[4]);
-    int weather_type=std::stoi(argv[5]);
-    
-    int numNodes = 240;  // Example number of nodes
-    Graph graph(numNodes);
-
-    if(time_type<=10){
-        time_type=1;
-    }
-    else{
-        time_type=0;
-    }
-
-    // Add all the edges as in the original code
-    int type_type= (typeNode==1) ? 1: 0;
-    //for car
-    if(type_type==0){
-        graph.addEdge(0, 1, 19);    // Main Gate
-    graph.addEdge(1, 2, 13);    // towards enrollment office
-    graph.addEdge(2, 3, 35);    // towards enrollment office
-    graph.addEdge(3, 4, 27);    // Front of enrollment office
-    graph.addEdge(4, 6, 28);    // Front of amphitheater
-    graph.addEdge(6, 7, 35);    // Front of sitting area
-    graph.addEdge(7, 10, 12);   // Front of GYM & MAC
-    graph.addEdge(10, 13, 10);  // Parking start front of MAC
-    graph.addEdge(13, 14, 11);  // Front of box
-    graph.addEdge(14, 15, 17);  // End of box
-    graph.addEdge(15, 16, 16);  // Staircase front of MAC
-    graph.addEdge(16, 17, 14);  // Front of Library
-    graph.addEdge(17, 18, 17);  // End of Library
-    graph.addEdge(18, 19, 32);  // Between blocks
-    graph.addEdge(19, 20, 7);   // Last stairs
-    graph.addEdge(20, 21, 23);  // Start of Gandhi Chowk
-    graph.addEdge(21, 22, 10);  // Front of Gandhi Chowk
-    graph.addEdge(22, 24, 5);   // Front of 9th block amphitheater
-    graph.addEdge(24, 25, 20);  // Back side of 3rd block & front of amphitheater
-    graph.addEdge(25, 28, 13);  // Backside of 9th block
-    graph.addEdge(28, 29, 3);   // Backside of Frisco
-    graph.addEdge(29, 30, 12);  // Backside of Frisco towards food court
-    graph.addEdge(30, 31, 5);   // Backside of 5th block
-    graph.addEdge(31, 33, 27);  // Backside of Food Court
-    graph.addEdge(33, 34, 20);  // Front side of food court 1st gate
-    graph.addEdge(34, 37, 7);   // Front of food court
-    graph.addEdge(37, 38, 6);   // Towards Hubble
-    graph.addEdge(43, 44, 24);  // Towards main gate back of Hubble
-    graph.addEdge(44, 45, 10);  // Towards main gate back of Hubble
-    graph.addEdge(45, 1, 57);   // Front of gate
-    graph.addEdge(1, 46, 15);   // Towards front of Hubble
-    graph.addEdge(46, 47, 25);  // Front of Hubble
-    graph.addEdge(47, 49, 10);  // Hubble towards 1st block
-    graph.addEdge(49, 3, 20);   // Hubble towards enrollment office
-    graph.addEdge(53, 38, 20);  // Front side of 2nd gate of food court
-    graph.addEdge(53, 43, 23);  // Backside of Hubble
-    graph.addEdge(55, 49, 13);  // Towards Hubble
-    graph.addEdge(54, 56, 9);   // Inside 1st block & front of wash room
-    graph.addEdge(62, 55, 54);  // Front side of 1st block & towards Hubble
-    graph.addEdge(63, 64, 30);  // Towards MAC
-    graph.addEdge(64, 7, 17);   // Towards sitting area behind MAC
-    graph.addEdge(64, 10, 9);   // Towards MAC/GYM
-    graph.addEdge(63, 65, 17);  // Towards lib stairs
-    graph.addEdge(65, 66, 61);  // Towards Gandhi Chowk
-    graph.addEdge(66, 67, 10);  // Towards Gandhi Chowk
-    graph.addEdge(66, 24, 28);  // Towards Gandhi Chowk
-    graph.addEdge(61, 79, 46);  // Outside 1st block path
-    graph.addEdge(79, 77, 10);  // Outside 1st block to 2nd block 2nd path
-    graph.addEdge(95, 96, 17);  // Path 6th block main entrance
-    graph.addEdge(96, 97, 31);  // Path from 6th block to main road
-    graph.addEdge(95, 99, 31);  // 6th to library road
-    graph.addEdge(99, 100, 15); // Main road from library to IT
-    graph.addEdge(100, 101, 26); // Main road to food court 2
-    graph.addEdge(105, 106, 43); // Towards power house
-    graph.addEdge(115, 97, 66);  // Main road to front of game office
-    graph.addEdge(116, 117, 8);  // Main road for placement activity
-    graph.addEdge(131, 117, 28); // Entrance of ground to intersection of MDP Guest house
-    graph.addEdge(131, 132, 5);  // Towards Guest house front of Ground
-    graph.addEdge(132, 133, 34); // Front gate of guest house
-    graph.addEdge(131, 135, 10); // Towards guest house and girls hostel
-    graph.addEdge(135, 136, 28); // 2nd gate of guest house
-    graph.addEdge(135, 136, 47); // Girls hostel main gate
-    graph.addEdge(136, 137, 12); // Girls hostel entrance gate
-    graph.addEdge(115, 139, 10); // 2nd gate of fire station
-    graph.addEdge(97, 140, 29);  // Towards Gandhi Chowk
-    graph.addEdge(140, 141, 22); // Towards Gandhi Chowk
-    graph.addEdge(141, 143, 10); // Gandhi Chowk
-    graph.addEdge(143, 22, 11);  // Towards other block
-    graph.addEdge(141, 144, 17); // Towards 9th block
-    graph.addEdge(141, 145, 10); // Towards body hostel
-    graph.addEdge(145, 146, 38); // Towards play school
-    graph.addEdge(146, 148, 14); // Front of canteen
-    graph.addEdge(148, 150, 33); // Front of Tulip towards boys hotel 
-    graph.addEdge(150, 152, 23); // Front of laboratory
-    graph.addEdge(152, 154, 10); // Towards car gate of boys hostel
-    graph.addEdge(152, 159, 10); // Sitting area towards Tulip
-    graph.addEdge(159, 160, 18); // Front of Tulip
-    graph.addEdge(160, 161, 2);  // Towards Tulip 1st gate
-    graph.addEdge(163, 164, 3);  // Towards 11th block 1st gate
-    graph.addEdge(164, 165, 21); // 11th and 10th block
-    graph.addEdge(165, 166, 23); // Towards Gandhi Chowk 9th and 10th block
-    graph.addEdge(166, 167, 36); // Towards Gandhi Chowk 9th block
-    graph.addEdge(167, 168, 33); // Towards Gandhi Chowk 9th last gate
-    graph.addEdge(168, 184, 4);  // Towards play school
-    graph.addEdge(184, 185, 8);  // Towards amphitheater
-    graph.addEdge(185, 24, 13);  // Towards 3rd block
-    graph.addEdge(175, 195, 23); // Backroad of 11th and 10th block
-    }
-
-
-    else if(type_type==1 && weather_type==1 ){
-        graph.addEdge(0, 1, 19);    // Main Gate
-        graph.addEdge(1, 2, 13);    // towards enrollment office
-        graph.addEdge(3, 4, 27);    // Front of enrollment office
-        graph.addEdge(4, 5, 21);    // Door of Enrollment office
-        graph.addEdge(7, 8, 7);     // Route for sitting area
-        graph.addEdge(8, 9, 1);     // Sitting area
-        graph.addEdge(7, 10, 12);   // Front of GYM & MAC
-    graph.addEdge(10, 11, 11);  // GYM Gate
-    graph.addEdge(10, 12, 11);  // MAC Gate
-    graph.addEdge(10, 13, 10);  // Parking start front of MAC
-    graph.addEdge(13, 14, 11);  // Front of box
-    graph.addEdge(14, 15, 17);  // End of box
-    graph.addEdge(15, 16, 16);  // Staircase front of MAC
-    graph.addEdge(16, 17, 14);  // Front of Library
-    graph.addEdge(17, 18, 17);  // End of Library
-    graph.addEdge(18, 19, 32);  // Between blocks
-    graph.addEdge(19, 20, 7);   // Last stairs
-    graph.addEdge(20, 21, 23);  // Start of Gandhi Chowk
-    graph.addEdge(21, 22, 10);  // Front of Gandhi Chowk
-    graph.addEdge(22, 23, 6);   // Gandhi Chowk
-    graph.addEdge(22, 24, 5);   // Front of 9th block amphitheater
-    graph.addEdge(24, 25, 20);  // Back side of 3rd block & front of amphitheater
-    graph.addEdge(25, 26, 3);   // Back of 3rd block
-    graph.addEdge(25, 28, 13);  // Backside of 9th block
-    graph.addEdge(28, 29, 3);   // Backside of Frisco
-    graph.addEdge(29, 30, 12);  // Backside of Frisco towards food court
-    graph.addEdge(30, 31, 5);   // Backside of 5th block
-    graph.addEdge(31, 32, 3);   // Backside entrance of 5th block
-    graph.addEdge(34, 35, 10);  // Main gate of food court
-    graph.addEdge(34, 36, 9);   // Stair towards food court
-    graph.addEdge(34, 37, 7);   // Front of food court
-    graph.addEdge(37, 38, 6);   // Towards Hubble
-    graph.addEdge(38, 39, 8);   // Food court 2nd gate towards Hubble
-    graph.addEdge(39, 40, 4);   // 2nd gate of food court
-    graph.addEdge(39, 41, 14);  // Narrow route towards main gate through food court
-    graph.addEdge(41, 42, 17);  // Front route towards main gate
-    graph.addEdge(42, 68, 14);  // Food court1 back gate 
-    graph.addEdge(68, 69, 2);   // Inside food court through back gate
-    graph.addEdge(69, 70, 2);   // Inside food court towards 2nd gate
-    graph.addEdge(70, 40, 10);  // Inside food court towards 2nd gate outwards
-    graph.addEdge(69, 71, 10);  // Inside food court towards 1st gate
-    graph.addEdge(71, 35, 9);   // Inside food court towards 1st gate outwards
-    graph.addEdge(1, 46, 15);   // Towards front of Hubble
-    graph.addEdge(46, 47, 25);  // Front of Hubble
-    graph.addEdge(47, 48, 4);   // Hubble main gate
-    graph.addEdge(47, 49, 10);  // Hubble towards 1st block
-    graph.addEdge(49, 3, 20);   // Hubble towards enrollment office
-    graph.addEdge(49, 50, 9);   // Side of Hubble towards 1st block
-    graph.addEdge(50, 51, 6);   // Towards 1st block
-    graph.addEdge(51, 52, 52);  // Towards food court
-    graph.addEdge(52, 53, 4);   // Towards food court backside of Hubble
-    graph.addEdge(53, 38, 20);  // Front side of 2nd gate of food court
-    graph.addEdge(51, 54, 9);   // 1st door of 1st block
-    graph.addEdge(54, 55, 12);  // Towards amphitheater
-    graph.addEdge(55, 49, 13);  // Towards Hubble
-    graph.addEdge(54, 56, 9);   // Inside 1st block & front of wash room
-    graph.addEdge(56, 57, 32);  // Inside 1st block & towards 4th block
-    graph.addEdge(57, 58, 32);  // Inside 1st block towards 2nd block
-    graph.addEdge(58, 59, 20);  // Inside 1st block towards 2nd block
-    graph.addEdge(59, 56, 32);  // Inside 1st block towards Library stairs
-    graph.addEdge(59, 60, 7);   // Exit of 1st block through library stairs
-    graph.addEdge(60, 61, 7);   // Towards library stairs
-    graph.addEdge(61, 62, 14);  // Front side of 1st block
-    graph.addEdge(62, 55, 54);  // Front side of 1st block & towards Hubble
-    graph.addEdge(62, 63, 15);  // Climbing through lib stairs
-    graph.addEdge(63, 64, 30);  // Towards MAC
-    graph.addEdge(64, 7, 17);   // Towards sitting area behind MAC
-    graph.addEdge(64, 10, 9);   // Towards MAC/GYM
-    graph.addEdge(63, 65, 17);  // Towards lib stairs
-    graph.addEdge(65, 16, 9);   // Towards Library
-    graph.addEdge(66, 67, 10);  // Towards Gandhi Chowk
-    graph.addEdge(66, 20, 13);  // Towards design block
-    graph.addEdge(66, 24, 28);  // Towards Gandhi Chowk
-    graph.addEdge(66, 72, 18);  // From stairs to 3rd block
-    graph.addEdge(72, 73, 2);   // Gate of 3rd block
-    graph.addEdge(72, 74, 3);   // Back gate of 2nd block
-    graph.addEdge(74, 75, 22);  // Towards 2nd block
-    graph.addEdge(75, 76, 6);   // 2nd block stairs
-    graph.addEdge(76, 77, 2);   // 2nd block gate
-    graph.addEdge(77, 78, 4);   // 2nd block to 1st block
-    graph.addEdge(78, 58, 16);  // Inside 1st block towards Hubble
-    graph.addEdge(61, 79, 46);  // Outside 1st block path
-    graph.addEdge(79, 77, 10);  // Outside 1st block to 2nd block 2nd path
-    graph.addEdge(57, 80, 10);  // 1st block to 4th block
-    graph.addEdge(80, 81, 8);   // 1st block path to 4th block path
-    graph.addEdge(81, 82, 3);   // 4th block gate
-    graph.addEdge(82, 83, 3);   // 4th block stairs
-    graph.addEdge(83, 84, 9);   // 4th block stair continues
-    graph.addEdge(84, 85, 22);  // 4th block last gate
-    graph.addEdge(85, 86, 4);   // 4th to 5th block
-    graph.addEdge(86, 87, 2);   // 5th block gate
-    graph.addEdge(52, 81, 22);  // Hubble to 4th block gate & 1st block gate
-    graph.addEdge(86, 87, 23);  // 5th block stairs
-    graph.addEdge(87, 88, 5);   // 5th block stairs
-    graph.addEdge(88, 32, 8);   // 5th block gate
-    graph.addEdge(17, 89, 51);  // Main road to library (staircase)
-    graph.addEdge(18, 93, 39);  // Main road to side of IT
-    graph.addEdge(90, 93, 12);  // Main road to IT (staircase)
-    graph.addEdge(89, 90, 18);  // Library to IT
-    graph.addEdge(89, 91, 3);   // Main gate of Library
-    graph.addEdge(90, 92, 3);   // Main gate of IT
-    graph.addEdge(93, 94, 26);  // Path towards 6th block
-    graph.addEdge(94, 95, 24);  // Path towards backside of 6th block
-    graph.addEdge(95, 96, 17);  // Path 6th block main entrance
-    graph.addEdge(96, 97, 31);  // Path from 6th block to main road
-    graph.addEdge(96, 98, 5);   // 6th block main entrance
-    graph.addEdge(95, 99, 31);  // 6th to library road
-    graph.addEdge(99, 90, 18);  // IT to main road
-    graph.addEdge(99, 100, 15); // Main road from library to IT
-    graph.addEdge(100, 89, 15); // Main road to Library
-    graph.addEdge(100, 101, 26); // Main road to food court 2
-    graph.addEdge(101, 102, 31); // Main road towards to backside of foodcourt
-    graph.addEdge(102, 103, 15); // Food court backside road
-    graph.addEdge(103, 104, 16); // Backside of food court to backside of MAC
-    graph.addEdge(104, 105, 11); // Backside of MAC
-    graph.addEdge(105, 106, 43); // Towards power house
-    graph.addEdge(106, 107, 5);  // Power house gate
-    graph.addEdge(107, 108, 9);  // Power house to basketball court
-    graph.addEdge(108, 109, 47); // Basketball court
-    graph.addEdge(109, 110, 54); // Basketball court exit 
-    graph.addEdge(110, 111, 10); // Towards Placement office
-    graph.addEdge(111, 112, 3);  // Main road of placement office
-    graph.addEdge(103, 113, 14); // Box from food court back
-    graph.addEdge(113, 114, 11); // Box mid to box mid
-    graph.addEdge(114, 14, 11);  // Box to main road
-    graph.addEdge(115, 97, 66);  // Main road to front of game office
-    graph.addEdge(115, 116, 7);  // Main road to game office
-    graph.addEdge(116, 117, 8);  // Main road for placement activity
-    graph.addEdge(117, 118, 47); // Main road towards placement activity
-    graph.addEdge(118, 119, 3);  // Towards ground
-    graph.addEdge(118, 112, 50); // Basketball court
-    graph.addEdge(120, 112, 7);  // Basketball entrance to ground entrance
-    graph.addEdge(112, 121, 36); // Basketball entrance to placement activity block
-    graph.addEdge(121, 122, 33); // Inside placement block
-    graph.addEdge(122, 123, 25); // Exit from placement block
-    graph.addEdge(123, 124, 71); // Corner of ground
-    graph.addEdge(124, 125, 104); // Other side of ground
-    graph.addEdge(125, 126, 32); // Front side of ground
-    graph.addEdge(126, 127, 18); // Towards ground
-    graph.addEdge(127, 128, 25); // Front side of ground
-    graph.addEdge(128, 129, 36); // Towards basketball ground
-    graph.addEdge(129, 130, 10); // Basketball back
-    graph.addEdge(130, 119, 13); // Basketball back
-    graph.addEdge(131, 128, 40); // Intersection in front of MDP Guest house
-    graph.addEdge(131, 117, 28); // Entrance of ground to intersection of MDP Guest house
-    graph.addEdge(131, 132, 5);  // Towards Guest house front of Ground
-    graph.addEdge(132, 133, 34); // Front gate of guest house
-    graph.addEdge(117, 134, 8);  // Museum way
-    graph.addEdge(131, 135, 10); // Towards guest house and girls hostel
-    graph.addEdge(135, 136, 28); // 2nd gate of guest house
-    graph.addEdge(136, 133, 15); // Gate to gate guest house
-    graph.addEdge(135, 136, 47); // Girls hostel main gate
-    graph.addEdge(136, 137, 12); // Girls hostel entrance gate
-    graph.addEdge(136, 138, 27); // Temple
-    graph.addEdge(115, 139, 10); // 2nd gate of fire station
-    graph.addEdge(97, 140, 29);  // Towards Gandhi Chowk
-    graph.addEdge(140, 141, 22); // Towards Gandhi Chowk
-    graph.addEdge(141, 142, 6);  // Towards amphitheater
-    graph.addEdge(141, 143, 10); // Gandhi Chowk
-    graph.addEdge(143, 22, 11);  // Towards other block
-    graph.addEdge(141, 144, 17); // Towards 9th block
-    graph.addEdge(141, 145, 10); // Towards body hostel
-    graph.addEdge(145, 146, 38); // Towards play school
-    graph.addEdge(146, 147, 5);  // Entrance of play school
-    graph.addEdge(146, 148, 14); // Front of canteen
-    graph.addEdge(148, 149, 12); // Gate of canteen
-    graph.addEdge(148, 150, 33); // Front of Tulip towards boys hotel 
-    graph.addEdge(150, 151, 4);  // Tulip 2nd gate towards boys hostel
-    graph.addEdge(150, 152, 23); // Front of laboratory
-    graph.addEdge(152, 153, 4);  // Gate of Laboratory
-    graph.addEdge(152, 154, 10); // Towards car gate of boys hostel
-    graph.addEdge(154, 155, 5);  // Car gate of boys hostel
-    graph.addEdge(154, 156, 6);  // Towards boys hostel entrance
-    graph.addEdge(156, 157, 6);  // Boys hostel gate
-    graph.addEdge(152, 159, 10); // Sitting area towards Tulip
-    graph.addEdge(159, 160, 18); // Front of Tulip
-    graph.addEdge(160, 161, 2);  // Towards Tulip 1st gate
-    graph.addEdge(161, 162, 4);  // 1st gate of Tulip
-    graph.addEdge(159, 163, 17); // Towards 11th block
-    graph.addEdge(163, 164, 3);  // Towards 11th block 1st gate
-    graph.addEdge(168, 184, 4);  // Towards play school
-    graph.addEdge(184, 185, 8);  // Towards amphitheater
-    graph.addEdge(185, 186, 13); // Towards 9th block
-    graph.addEdge(185, 24, 13);  // Towards 3rd block
-    graph.addEdge(186, 27, 4);   // Towards 9th block main entrance
-    graph.addEdge(186, 25, 12);  // Towards 3rd block
-    graph.addEdge(188, 179, 4);  // Back gate stair of 9th block
-    graph.addEdge(179, 189, 8);  // Stair main gate of 10th block
-    graph.addEdge(189, 190, 3);  // Main gate of 10th block
-    graph.addEdge(188, 191, 8);  // Back gate of 9th block
-    graph.addEdge(191, 192, 34); // Towards mid of 9th block
-    graph.addEdge(192, 187, 11); // Mid gate of 9th block
-    graph.addEdge(192, 182, 31); // Front gate of 9th block
-    graph.addEdge(190, 193, 27); // Mid of 10th block
-    graph.addEdge(193, 176, 24); // End gate of 10th block
-    graph.addEdge(193, 194, 11); // Mid gate of 10th block
-    graph.addEdge(194, 195, 3);  // Between 11th and 10th block
-    graph.addEdge(195, 196, 5);  // Downside gate of 11th block
-    graph.addEdge(196, 197, 4);  // Towards 11th block stairs
-    graph.addEdge(197, 198, 6);  // Towards 11th block stairs
-    graph.addEdge(198, 199, 4);  // Towards 11th block stairs
-    graph.addEdge(199, 200, 20); // Towards 11th block main gate
-    graph.addEdge(200, 201, 4);  // Towards 11th block gate
-    graph.addEdge(201, 202, 1);  // Towards main gate of 11th block
-    graph.addEdge(202, 203, 3);  // Main gate of 11th block
-    graph.addEdge(202, 204, 12); // Towards intersection part
-    graph.addEdge(203, 205, 2);  // Towards main road
-    graph.addEdge(205, 164, 16); // 11th block main road
-    graph.addEdge(175, 195, 23); // Backroad of 11th and 10th block
-    graph.addEdge(206, 207, 3);  // Towards mid of 10th and 11th block
-    graph.addEdge(207, 195, 23); // Mid of 10th and 11th block
-    graph.addEdge(170, 204, 18); // Intersection point
-    graph.addEdge(170, 208, 17); // Towards 3rd gate of 11th block
-    graph.addEdge(170, 209, 19); // Mid gate of 11th block
-    graph.addEdge(208, 210, 8);  // Last gate to entrance
-    graph.addEdge(210, 211, 3);  // Last gate inside 11th block
-    graph.addEdge(211, 212, 8);  // Inside 11th block
-    graph.addEdge(212, 213, 25); // Inside 11th block
-    graph.addEdge(213, 214, 23); // Mid gate of 11th block
-    graph.addEdge(214, 209, 4);  // Mid gate entrance
-    graph.addEdge(214, 215, 25); // Towards main gate of 11th block
-    graph.addEdge(215, 199, 5);  // Towards stair of 11th block
-    graph.addEdge(30, 216, 6);   // Towards Frisco
-    graph.addEdge(216, 217, 4);  // Towards 3rd block
-    graph.addEdge(216, 218, 7);  // Towards Frisco
-    graph.addEdge(219, 31, 10);  // Towards 5th block
-    graph.addEdge(219, 220, 5);  // 5th block gate
-    graph.addEdge(219, 221, 7);  // Towards Frisco
-    graph.addEdge(221, 222, 6);  // Towards Frisco entrance
-    graph.addEdge(218, 222, 5);  // Towards Frisco entrance
-    graph.addEdge(222, 223, 3);  // Frisco entrance
-    graph.addEdge(218, 224, 16); //
-    graph.addEdge(221, 225, 16); //
-    graph.addEdge(218, 225, 18); 
-    graph.addEdge(224, 221, 18); //
-    graph.addEdge(224, 225, 12); //
-    graph.addEdge(225, 85, 16); 
-    graph.addEdge(224, 72, 15); //
-    graph.addEdge(225, 226, 29); //
-    graph.addEdge(226, 81, 5); 
-    graph.addEdge(226, 227, 8); //
-    graph.addEdge(227, 228, 6); //
-    graph.addEdge(228, 229, 4);
-    graph.addEdge(228, 224, 27); 
-    graph.addEdge(229, 76, 4);
-    graph.addEdge(228, 77, 4); 
-    graph.addEdge(227, 230, 3); 
-    graph.addEdge(231, 50, 12);
-    graph.addEdge(231, 48, 9);
- 
-    }
-    else if(type_type==1 && time_type==0 && weather_type==0){
-        graph.addEdge(0, 1, 19);    // Main Gate
-        graph.addEdge(1, 2, 13);    // towards enrollment office
-        graph.addEdge(2, 3, 35);    // towards enrollment office
-        graph.addEdge(3, 4, 27);    // Front of enrollment office
-        graph.addEdge(4, 5, 21);    // Door of Enrollment office
-        graph.addEdge(4, 6, 28);    // Front of amphitheater
-        graph.addEdge(6, 7, 35);    // Front of sitting area
-        graph.addEdge(7, 8, 7);     // Route for sitting area
-        graph.addEdge(8, 9, 1);     // Sitting area
-        graph.addEdge(7, 10, 12);   // Front of GYM & MAC
-        graph.addEdge(10, 11, 11);  // GYM Gate
-        graph.addEdge(10, 12, 11);  // MAC Gate
-        graph.addEdge(10, 13, 10);  // Parking start front of MAC
-    graph.addEdge(13, 14, 11);  // Front of box
-    graph.addEdge(14, 15, 17);  // End of box
-    graph.addEdge(15, 16, 16);  // Staircase front of MAC
-    graph.addEdge(16, 17, 14);  // Front of Library
-    graph.addEdge(17, 18, 17);  // End of Library
-    graph.addEdge(18, 19, 32);  // Between blocks
-    graph.addEdge(19, 20, 7);   // Last stairs
-    graph.addEdge(20, 21, 23);  // Start of Gandhi Chowk
-    graph.addEdge(21, 22, 10);  // Front of Gandhi Chowk
-    graph.addEdge(22, 23, 6);   // Gandhi Chowk
-    graph.addEdge(22, 24, 5);   // Front of 9th block amphitheater
-    graph.addEdge(24, 25, 20);  // Back side of 3rd block & front of amphitheater
-    graph.addEdge(25, 26, 3);   // Back of 3rd block
-    graph.addEdge(25, 28, 13);  // Backside of 9th block
-    graph.addEdge(28, 29, 3);   // Backside of Frisco
-    graph.addEdge(29, 30, 12);  // Backside of Frisco towards food court
-    graph.addEdge(30, 31, 5);   // Backside of 5th block
-    graph.addEdge(31, 32, 3);   // Backside entrance of 5th block
-    graph.addEdge(31, 33, 27);  // Backside of Food Court
-    graph.addEdge(33, 34, 20);  // Front side of food court 1st gate
-    graph.addEdge(34, 35, 10);  // Main gate of food court
-    graph.addEdge(34, 36, 9);   // Stair towards food court
-    graph.addEdge(34, 37, 7);   // Front of food court
-    graph.addEdge(37, 38, 6);   // Towards Hubble
-    graph.addEdge(38, 39, 8);   // Food court 2nd gate towards Hubble
-    graph.addEdge(39, 40, 4);   // 2nd gate of food court
-    graph.addEdge(39, 41, 14);  // Narrow route towards main gate through food court
-    graph.addEdge(41, 42, 17);  // Front route towards main gate
-    graph.addEdge(42, 43, 15);  // Connecting route towards main gate / back side of Hubble
-    graph.addEdge(42, 68, 14);  // Food court1 back gate 
-    graph.addEdge(68, 69, 2);   // Inside food court through back gate
-    graph.addEdge(69, 70, 2);   // Inside food court towards 2nd gate
-    graph.addEdge(70, 40, 10);  // Inside food court towards 2nd gate outwards
-    graph.addEdge(69, 71, 10);  // Inside food court towards 1st gate
-    graph.addEdge(71, 35, 9);   // Inside food court towards 1st gate outwards
-    graph.addEdge(43, 44, 24);  // Towards main gate back of Hubble
-    graph.addEdge(44, 45, 10);  // Towards main gate back of Hubble
-    graph.addEdge(45, 1, 57);   // Front of gate
-    graph.addEdge(1, 46, 15);   // Towards front of Hubble
-    graph.addEdge(46, 47, 25);  // Front of Hubble
-    graph.addEdge(47, 48, 4);   // Hubble main gate
-    graph.addEdge(47, 49, 10);  // Hubble towards 1st block
-    graph.addEdge(49, 3, 20);   // Hubble towards enrollment office
-    graph.addEdge(49, 50, 9);   // Side of Hubble towards 1st block
-    graph.addEdge(50, 51, 6);   // Towards 1st block
-    graph.addEdge(51, 52, 52);  // Towards food court
-    graph.addEdge(52, 53, 4);   // Towards food court backside of Hubble
-    graph.addEdge(53, 38, 20);  // Front side of 2nd gate of food court
-    graph.addEdge(53, 43, 23);  // Backside of Hubble
-    graph.addEdge(51, 54, 9);   // 1st door of 1st block
-    graph.addEdge(54, 55, 12);  // Towards amphitheater
-    graph.addEdge(55, 49, 13);  // Towards Hubble
-    graph.addEdge(54, 56, 9);   // Inside 1st block & front of wash room
-    graph.addEdge(56, 57, 32);  // Inside 1st block & towards 4th block
-    graph.addEdge(57, 58, 32);  // Inside 1st block towards 2nd block
-    graph.addEdge(58, 59, 20);  // Inside 1st block towards 2nd block
-    graph.addEdge(59, 56, 32);  // Inside 1st block towards Library stairs
-    graph.addEdge(59, 60, 7);   // Exit of 1st block through library stairs
-    graph.addEdge(60, 61, 7);   // Towards library stairs
-    graph.addEdge(61, 62, 14);  // Front side of 1st block
-    graph.addEdge(62, 55, 54);  // Front side of 1st block & towards Hubble
-    graph.addEdge(62, 63, 15);  // Climbing through lib stairs
-    graph.addEdge(63, 64, 30);  // Towards MAC
-    graph.addEdge(64, 7, 17);   // Towards sitting area behind MAC
-    graph.addEdge(64, 10, 9);   // Towards MAC/GYM
-    graph.addEdge(63, 65, 17);  // Towards lib stairs
-    graph.addEdge(65, 16, 9);   // Towards Library
-    graph.addEdge(65, 66, 61);  // Towards Gandhi Chowk
-    graph.addEdge(66, 67, 10);  // Towards Gandhi Chowk
-    graph.addEdge(66, 20, 13);  // Towards design block
-    graph.addEdge(66, 24, 28);  // Towards Gandhi Chowk
-    graph.addEdge(66, 72, 18);  // From stairs to 3rd block
-    graph.addEdge(72, 73, 2);   // Gate of 3rd block
-    graph.addEdge(72, 74, 3);   // Back gate of 2nd block
-    graph.addEdge(74, 75, 22);  // Towards 2nd block
-    graph.addEdge(75, 76, 6);   // 2nd block stairs
-    graph.addEdge(76, 77, 2);   // 2nd block gate
-    graph.addEdge(77, 78, 4);   // 2nd block to 1st block
-    graph.addEdge(78, 58, 16);  // Inside 1st block towards Hubble
-    graph.addEdge(61, 79, 46);  // Outside 1st block path
-    graph.addEdge(79, 77, 10);  // Outside 1st block to 2nd block 2nd path
-    graph.addEdge(57, 80, 10);  // 1st block to 4th block
-    graph.addEdge(80, 81, 8);   // 1st block path to 4th block path
-    graph.addEdge(81, 82, 3);   // 4th block gate
-    graph.addEdge(82, 83, 3);   // 4th block stairs
-    graph.addEdge(83, 84, 9);   // 4th block stair continues
-    graph.addEdge(84, 85, 22);  // 4th block last gate
-    graph.addEdge(85, 86, 4);   // 4th to 5th block
-    graph.addEdge(86, 87, 2);   // 5th block gate
-    graph.addEdge(52, 81, 22);  // Hubble to 4th block gate & 1st block gate
-    graph.addEdge(86, 87, 23);  // 5th block stairs
-    graph.addEdge(87, 88, 5);   // 5th block stairs
-    graph.addEdge(88, 32, 8);   // 5th block gate
-    graph.addEdge(17, 89, 51);  // Main road to library (staircase)
-    graph.addEdge(18, 93, 39);  // Main road to side of IT
-    graph.addEdge(90, 93, 12);  // Main road to IT (staircase)
-    graph.addEdge(89, 90, 18);  // Library to IT
-    graph.addEdge(89, 91, 3);   // Main gate of Library
-    graph.addEdge(90, 92, 3);   // Main gate of IT
-    graph.addEdge(93, 94, 26);  // Path towards 6th block
-    graph.addEdge(94, 95, 24);  // Path towards backside of 6th block
-    graph.addEdge(95, 96, 17);  // Path 6th block main entrance
-    graph.addEdge(96, 97, 31);  // Path from 6th block to main road
-    graph.addEdge(96, 98, 5);   // 6th block main entrance
-    graph.addEdge(95, 99, 31);  // 6th to library road
-    graph.addEdge(99, 90, 18);  // IT to main road
-    graph.addEdge(99, 100, 15); // Main road from library to IT
-    graph.addEdge(100, 89, 15); // Main road to Library
-    graph.addEdge(100, 101, 26); // Main road to food court 2
-    graph.addEdge(101, 102, 31); // Main road towards to backside of foodcourt
-    graph.addEdge(102, 103, 15); // Food court backside road
-    graph.addEdge(103, 104, 16); // Backside of food court to backside of MAC
-    graph.addEdge(104, 105, 11); // Backside of MAC
-    graph.addEdge(105, 106, 43); // Towards power house
-    graph.addEdge(106, 107, 5);  // Power house gate
-    graph.addEdge(107, 108, 9);  // Power house to basketball court
-    graph.addEdge(108, 109, 47); // Basketball court
-    graph.addEdge(109, 110, 54); // Basketball court exit 
-    graph.addEdge(110, 111, 10); // Towards Placement office
-    graph.addEdge(111, 112, 3);  // Main road of placement office
-    graph.addEdge(103, 113, 14); // Box from food court back
-    graph.addEdge(113, 114, 11); // Box mid to box mid
-    graph.addEdge(114, 14, 11);  // Box to main road
-    graph.addEdge(115, 97, 66);  // Main road to front of game office
-    graph.addEdge(115, 116, 7);  // Main road to game office
-    graph.addEdge(116, 117, 8);  // Main road for placement activity
-    graph.addEdge(117, 118, 47); // Main road towards placement activity
-    graph.addEdge(118, 119, 3);  // Towards ground
-    graph.addEdge(118, 112, 50); // Basketball court
-    graph.addEdge(120, 112, 7);  // Basketball entrance to ground entrance
-    graph.addEdge(112, 121, 36); // Basketball entrance to placement activity block
-    graph.addEdge(121, 122, 33); // Inside placement block
-    graph.addEdge(122, 123, 25); // Exit from placement block
-    graph.addEdge(123, 124, 71); // Corner of ground
-    graph.addEdge(124, 125, 104); // Other side of ground
-    graph.addEdge(125, 126, 32); // Front side of ground
-    graph.addEdge(126, 127, 18); // Towards ground
-    graph.addEdge(127, 128, 25); // Front side of ground
-    graph.addEdge(128, 129, 36); // Towards basketball ground
-    graph.addEdge(129, 130, 10); // Basketball back
-    graph.addEdge(130, 119, 13); // Basketball back
-    graph.addEdge(131, 128, 40); // Intersection in front of MDP Guest house
-    graph.addEdge(131, 117, 28); // Entrance of ground to intersection of MDP Guest house
-    graph.addEdge(131, 132, 5);  // Towards Guest house front of Ground
-    graph.addEdge(132, 133, 34); // Front gate of guest house
-    graph.addEdge(117, 134, 8);  // Museum way
-    graph.addEdge(131, 135, 10); // Towards guest house and girls hostel
-    graph.addEdge(135, 136, 28); // 2nd gate of guest house
-    graph.addEdge(136, 133, 15); // Gate to gate guest house
-    graph.addEdge(135, 136, 47); // Girls hostel main gate
-    graph.addEdge(136, 137, 12); // Girls hostel entrance gate
-    graph.addEdge(136, 138, 27); // Temple
-    graph.addEdge(115, 139, 10); // 2nd gate of fire station
-    graph.addEdge(97, 140, 29);  // Towards Gandhi Chowk
-    graph.addEdge(140, 141, 22); // Towards Gandhi Chowk
-    graph.addEdge(141, 142, 6);  // Towards amphitheater
-    graph.addEdge(141, 143, 10); // Gandhi Chowk
-    graph.addEdge(143, 22, 11);  // Towards other block
-    graph.addEdge(141, 144, 17); // Towards 9th block
-    graph.addEdge(141, 145, 10); // Towards body hostel
-    graph.addEdge(145, 146, 38); // Towards play school
-    graph.addEdge(146, 147, 5);  // Entrance of play school
-    graph.addEdge(146, 148, 14); // Front of canteen
-    graph.addEdge(148, 149, 12); // Gate of canteen
-    graph.addEdge(148, 150, 33); // Front of Tulip towards boys hotel 
-    graph.addEdge(150, 151, 4);  // Tulip 2nd gate towards boys hostel
-    graph.addEdge(150, 152, 23); // Front of laboratory
-    graph.addEdge(152, 153, 4);  // Gate of Laboratory
-    graph.addEdge(152, 154, 10); // Towards car gate of boys hostel
-    graph.addEdge(154, 155, 5);  // Car gate of boys hostel
-    graph.addEdge(154, 156, 6);  // Towards boys hostel entrance
-    graph.addEdge(156, 157, 6);  // Boys hostel gate
-    graph.addEdge(152, 159, 10); // Sitting area towards Tulip
-    graph.addEdge(159, 160, 18); // Front of Tulip
-    graph.addEdge(160, 161, 2);  // Towards Tulip 1st gate
-    graph.addEdge(161, 162, 4);  // 1st gate of Tulip
-    graph.addEdge(159, 163, 17); // Towards 11th block
-    graph.addEdge(163, 164, 3);  // Towards 11th block 1st gate
-    graph.addEdge(164, 165, 21); // 11th and 10th block
-    graph.addEdge(165, 166, 23); // Towards Gandhi Chowk 9th and 10th block
-    graph.addEdge(166, 167, 36); // Towards Gandhi Chowk 9th block
-    graph.addEdge(167, 168, 33); // Towards Gandhi Chowk 9th last gate
-    graph.addEdge(168, 184, 4);  // Towards play school
-    graph.addEdge(184, 185, 8);  // Towards amphitheater
-    graph.addEdge(185, 186, 13); // Towards 9th block
-    graph.addEdge(185, 24, 13);  // Towards 3rd block
-    graph.addEdge(186, 27, 4);   // Towards 9th block main entrance
-    graph.addEdge(186, 25, 12);  // Towards 3rd block
-    graph.addEdge(187, 167, 5);  // Mid gate of 9th block
-    graph.addEdge(188, 179, 4);  // Back gate stair of 9th block
-    graph.addEdge(179, 189, 8);  // Stair main gate of 10th block
-    graph.addEdge(189, 190, 3);  // Main gate of 10th block
-    graph.addEdge(188, 191, 8);  // Back gate of 9th block
-    graph.addEdge(191, 192, 34); // Towards mid of 9th block
-    graph.addEdge(192, 187, 11); // Mid gate of 9th block
-    graph.addEdge(192, 182, 31); // Front gate of 9th block
-    graph.addEdge(190, 193, 27); // Mid of 10th block
-    graph.addEdge(193, 176, 24); // End gate of 10th block
-    graph.addEdge(193, 194, 11); // Mid gate of 10th block
-    graph.addEdge(194, 195, 3);  // Between 11th and 10th block
-    graph.addEdge(195, 196, 5);  // Downside gate of 11th block
-    graph.addEdge(196, 197, 4);  // Towards 11th block stairs
-    graph.addEdge(197, 198, 6);  // Towards 11th block stairs
-    graph.addEdge(198, 199, 4);  // Towards 11th block stairs
-    graph.addEdge(199, 200, 20); // Towards 11th block main gate
-    graph.addEdge(200, 201, 4);  // Towards 11th block gate
-    graph.addEdge(201, 202, 1);  // Towards main gate of 11th block
-    graph.addEdge(202, 203, 3);  // Main gate of 11th block
-    graph.addEdge(202, 204, 12); // Towards intersection part
-    graph.addEdge(203, 205, 2);  // Towards main road
-    graph.addEdge(205, 164, 16); // 11th block main road
-    graph.addEdge(175, 195, 23); // Backroad of 11th and 10th block
-    graph.addEdge(165, 206, 19); // Main road towards mid of 11th and 10th block
-    graph.addEdge(206, 207, 3);  // Towards mid of 10th and 11th block
-    graph.addEdge(207, 195, 23); // Mid of 10th and 11th block
-    graph.addEdge(170, 204, 18); // Intersection point
-    graph.addEdge(170, 208, 17); // Towards 3rd gate of 11th block
-    graph.addEdge(170, 209, 19); // Mid gate of 11th block
-    graph.addEdge(208, 210, 8);  // Last gate to entrance
-    graph.addEdge(210, 211, 3);  // Last gate inside 11th block
-    graph.addEdge(211, 212, 8);  // Inside 11th block
-    graph.addEdge(212, 213, 25); // Inside 11th block
-    graph.addEdge(213, 214, 23); // Mid gate of 11th block
-    graph.addEdge(214, 209, 4);  // Mid gate entrance
-    graph.addEdge(214, 215, 25); // Towards main gate of 11th block
-    graph.addEdge(215, 199, 5);  // Towards stair of 11th block
-    graph.addEdge(30, 216, 6);   // Towards Frisco
-    graph.addEdge(216, 217, 4);  // Towards 3rd block
-    graph.addEdge(216, 218, 7);  // Towards Frisco
-    graph.addEdge(219, 31, 10);  // Towards 5th block
-    graph.addEdge(219, 220, 5);  // 5th block gate
-    graph.addEdge(219, 221, 7);  // Towards Frisco
-    graph.addEdge(221, 222, 6);  // Towards Frisco entrance
-    graph.addEdge(218, 222, 5);  // Towards Frisco entrance
-    graph.addEdge(222, 223, 3);  // Frisco entrance
-    graph.addEdge(218, 224, 16); //
-    graph.addEdge(221, 225, 16); //
-    graph.addEdge(218, 225, 18); 
-    graph.addEdge(224, 221, 18); //
-    graph.addEdge(224, 225, 12); //
-    graph.addEdge(225, 85, 16); 
-    graph.addEdge(224, 72, 15); //
-    graph.addEdge(225, 226, 29); //
-    graph.addEdge(226, 81, 5); 
-    graph.addEdge(226, 227, 8); //
-    graph.addEdge(227, 228, 6); //
-    graph.addEdge(228, 229, 4);
-    graph.addEdge(228, 224, 27); 
-    graph.addEdge(229, 76, 4);
-    graph.addEdge(228, 77, 4); 
-    graph.addEdge(227, 230, 3); 
-    graph.addEdge(231, 50, 12);
-    graph.addEdge(231, 48, 9);
-    }
-       // ... (add all other edges)
-
-    else if(type_type==1 && time_type==1){
-        graph.addEdge(0, 1, 19);    // Main Gate
-    graph.addEdge(2, 3, 35);    // towards enrollment office
-    graph.addEdge(3, 4, 27);    // Front of enrollment office
-    graph.addEdge(4, 5, 21);    // Door of Enrollment office
-    graph.addEdge(4, 6, 28);    // Front of amphitheater
-    graph.addEdge(6, 7, 35);    // Front of sitting area
-    graph.addEdge(7, 8, 7);     // Route for sitting area
-    graph.addEdge(8, 9, 1);     // Sitting area
-    graph.addEdge(7, 10, 12);   // Front of GYM & MAC
-    graph.addEdge(10, 11, 11);  // GYM Gate
-    graph.addEdge(10, 12, 11);  // MAC Gate
-    graph.addEdge(10, 13, 10);  // Parking start front of MAC
-    graph.addEdge(13, 14, 11);  // Front of box
-    graph.addEdge(14, 15, 17);  // End of box
-    graph.addEdge(15, 16, 16);  // Staircase front of MAC
-    graph.addEdge(16, 17, 14);  // Front of Library
-    graph.addEdge(17, 18, 17);  // End of Library
-    graph.addEdge(18, 19, 32);  // Between blocks
-    graph.addEdge(19, 20, 7);   // Last stairs
-    graph.addEdge(20, 21, 23);  // Start of Gandhi Chowk
-    graph.addEdge(21, 22, 10);  // Front of Gandhi Chowk
-    graph.addEdge(22, 23, 6);   // Gandhi Chowk
-    graph.addEdge(22, 24, 5);   // Front of 9th block amphitheater
-    graph.addEdge(24, 25, 20);  // Back side of 3rd block & front of amphitheater
-    graph.addEdge(25, 26, 3);   // Back of 3rd block
-    graph.addEdge(25, 28, 13);  // Backside of 9th block
-    graph.addEdge(28, 29, 3);   // Backside of Frisco
-    graph.addEdge(29, 30, 12);  // Backside of Frisco towards food court
-    graph.addEdge(30, 31, 5);   // Backside of 5th block
-    graph.addEdge(31, 32, 3);   // Backside entrance of 5th block
-    graph.addEdge(31, 33, 27);  // Backside of Food Court
-    graph.addEdge(33, 34, 20);  // Front side of food court 1st gate
-    graph.addEdge(34, 35, 10);  // Main gate of food court
-    graph.addEdge(34, 36, 9);   // Stair towards food court
-    graph.addEdge(34, 37, 7);   // Front of food court
-    graph.addEdge(37, 38, 6);   // Towards Hubble
-    graph.addEdge(38, 39, 8);   // Food court 2nd gate towards Hubble
-    graph.addEdge(39, 40, 4);   // 2nd gate of food court
-    graph.addEdge(39, 41, 14);  // Narrow route towards main gate through food court
-    graph.addEdge(41, 42, 17);  // Front route towards main gate
-    graph.addEdge(42, 43, 15);  // Connecting route towards main gate / back side of Hubble
-    graph.addEdge(42, 68, 14);  // Food court1 back gate 
-    graph.addEdge(68, 69, 2);   // Inside food court through back gate
-    graph.addEdge(69, 70, 2);   // Inside food court towards 2nd gate
-    graph.addEdge(70, 40, 10);  // Inside food court towards 2nd gate outwards
-    graph.addEdge(69, 71, 10);  // Inside food court towards 1st gate
-    graph.addEdge(71, 35, 9);   // Inside food court towards 1st gate outwards
-    graph.addEdge(43, 44, 24);  // Towards main gate back of Hubble
-    graph.addEdge(44, 45, 10);  // Towards main gate back of Hubble
-    graph.addEdge(45, 1, 57);   // Front of gate
-    graph.addEdge(46, 47, 25);  // Front of Hubble
-    graph.addEdge(47, 48, 4);   // Hubble main gate
-    graph.addEdge(47, 49, 10);  // Hubble towards 1st block
-    graph.addEdge(49, 3, 20);   // Hubble towards enrollment office
-    graph.addEdge(49, 50, 9);   // Side of Hubble towards 1st block
-    graph.addEdge(50, 51, 6);   // Towards 1st block
-    graph.addEdge(51, 52, 52);  // Towards food court
-    graph.addEdge(52, 53, 4);   // Towards food court backside of Hubble
-    graph.addEdge(53, 38, 20);  // Front side of 2nd gate of food court
-    graph.addEdge(53, 43, 23);  // Backside of Hubble
-    graph.addEdge(51, 54, 9);   // 1st door of 1st block
-    graph.addEdge(54, 55, 12);  // Towards amphitheater
-    graph.addEdge(55, 49, 13);  // Towards Hubble
-    graph.addEdge(54, 56, 9);   // Inside 1st block & front of wash room
-    graph.addEdge(56, 57, 32);  // Inside 1st block & towards 4th block
-    graph.addEdge(57, 58, 32);  // Inside 1st block towards 2nd block
-    graph.addEdge(58, 59, 20);  // Inside 1st block towards 2nd block
-    graph.addEdge(59, 56, 32);  // Inside 1st block towards Library stairs
-    graph.addEdge(59, 60, 7);   // Exit of 1st block through library stairs
-    graph.addEdge(60, 61, 7);   // Towards library stairs
-    graph.addEdge(61, 62, 14);  // Front side of 1st block
-    graph.addEdge(62, 55, 54);  // Front side of 1st block & towards Hubble
-    graph.addEdge(62, 63, 15);  // Climbing through lib stairs
-    graph.addEdge(63, 64, 30);  // Towards MAC
-    graph.addEdge(64, 7, 17);   // Towards sitting area behind MAC
-    graph.addEdge(64, 10, 9);   // Towards MAC/GYM
-    graph.addEdge(63, 65, 17);  // Towards lib stairs
-    graph.addEdge(65, 16, 9);   // Towards Library
-    graph.addEdge(65, 66, 61);  // Towards Gandhi Chowk
-    graph.addEdge(66, 67, 10);  // Towards Gandhi Chowk
-    graph.addEdge(66, 20, 13);  // Towards design block
-    graph.addEdge(66, 24, 28);  // Towards Gandhi Chowk
-    graph.addEdge(66, 72, 18);  // From stairs to 3rd block
-    graph.addEdge(72, 73, 2);   // Gate of 3rd block
-    graph.addEdge(72, 74, 3);   // Back gate of 2nd block
-    graph.addEdge(74, 75, 22);  // Towards 2nd block
-    graph.addEdge(75, 76, 6);   // 2nd block stairs
-    graph.addEdge(76, 77, 2);   // 2nd block gate
-    graph.addEdge(77, 78, 4);   // 2nd block to 1st block
-    graph.addEdge(78, 58, 16);  // Inside 1st block towards Hubble
-    graph.addEdge(61, 79, 46);  // Outside 1st block path
-    graph.addEdge(79, 77, 10);  // Outside 1st block to 2nd block 2nd path
-    graph.addEdge(57, 80, 10);  // 1st block to 4th block
-    graph.addEdge(80, 81, 8);   // 1st block path to 4th block path
-    graph.addEdge(81, 82, 3);   // 4th block gate
-    graph.addEdge(82, 83, 3);   // 4th block stairs
-    graph.addEdge(83, 84, 9);   // 4th block stair continues
-    graph.addEdge(84, 85, 22);  // 4th block last gate
-    graph.addEdge(85, 86, 4);   // 4th to 5th block
-    graph.addEdge(86, 87, 2);   // 5th block gate
-    graph.addEdge(52, 81, 22);  // Hubble to 4th block gate & 1st block gate
-    graph.addEdge(86, 87, 23);  // 5th block stairs
-    graph.addEdge(87, 88, 5);   // 5th block stairs
-    graph.addEdge(88, 32, 8);   // 5th block gate
-    graph.addEdge(17, 89, 51);  // Main road to library (staircase)
-    graph.addEdge(18, 93, 39);  // Main road to side of IT
-    graph.addEdge(90, 93, 12);  // Main road to IT (staircase)
-    graph.addEdge(89, 90, 18);  // Library to IT
-    graph.addEdge(89, 91, 3);   // Main gate of Library
-    graph.addEdge(90, 92, 3);   // Main gate of IT
-    graph.addEdge(93, 94, 26);  // Path towards 6th block
-    graph.addEdge(94, 95, 24);  // Path towards backside of 6th block
-    graph.addEdge(95, 96, 17);  // Path 6th block main entrance
-    graph.addEdge(96, 97, 31);  // Path from 6th block to main road
-    graph.addEdge(96, 98, 5);   // 6th block main entrance
-    graph.addEdge(95, 99, 31);  // 6th to library road
-    graph.addEdge(99, 90, 18);  // IT to main road
-    graph.addEdge(99, 100, 15); // Main road from library to IT
-    graph.addEdge(100, 89, 15); // Main road to Library
-    graph.addEdge(100, 101, 26); // Main road to food court 2
-    graph.addEdge(101, 102, 31); // Main road towards to backside of foodcourt
-    graph.addEdge(102, 103, 15); // Food court backside road
-    graph.addEdge(103, 104, 16); // Backside of food court to backside of MAC
-    graph.addEdge(104, 105, 11); // Backside of MAC
-    graph.addEdge(105, 106, 43); // Towards power house
-    graph.addEdge(106, 107, 5);  // Power house gate
-    graph.addEdge(107, 108, 9);  // Power house to basketball court
-    graph.addEdge(108, 109, 47); // Basketball court
-    graph.addEdge(109, 110, 54); // Basketball court exit 
-    graph.addEdge(110, 111, 10); // Towards Placement office
-    graph.addEdge(111, 112, 3);  // Main road of placement office
-    graph.addEdge(103, 113, 14); // Box from food court back
-    graph.addEdge(113, 114, 11); // Box mid to box mid
-    graph.addEdge(114, 14, 11);  // Box to main road
-    graph.addEdge(115, 97, 66);  // Main road to front of game office
-    graph.addEdge(115, 116, 7);  // Main road to game office
-    graph.addEdge(116, 117, 8);  // Main road for placement activity
-    graph.addEdge(117, 118, 47); // Main road towards placement activity
-    graph.addEdge(118, 119, 3);  // Towards ground
-    graph.addEdge(118, 112, 50); // Basketball court
-    graph.addEdge(120, 112, 7);  // Basketball entrance to ground entrance
-    graph.addEdge(112, 121, 36); // Basketball entrance to placement activity block
-    graph.addEdge(121, 122, 33); // Inside placement block
-    graph.addEdge(122, 123, 25); // Exit from placement block
-    graph.addEdge(123, 124, 71); // Corner of ground
-    graph.addEdge(124, 125, 104); // Other side of ground
-    graph.addEdge(125, 126, 32); // Front side of ground
-    graph.addEdge(126, 127, 18); // Towards ground
-    graph.addEdge(127, 128, 25); // Front side of ground
-    graph.addEdge(128, 129, 36); // Towards basketball ground
-    graph.addEdge(129, 130, 10); // Basketball back
-    graph.addEdge(130, 119, 13); // Basketball back
-    graph.addEdge(131, 128, 40); // Intersection in front of MDP Guest house
-    graph.addEdge(131, 117, 28); // Entrance of ground to intersection of MDP Guest house
-    graph.addEdge(131, 132, 5);  // Towards Guest house front of Ground
-    graph.addEdge(132, 133, 34); // Front gate of guest house
-    graph.addEdge(117, 134, 8);  // Museum way
-    graph.addEdge(131, 135, 10); // Towards guest house and girls hostel
-    graph.addEdge(135, 136, 28); // 2nd gate of guest house
-    graph.addEdge(136, 133, 15); // Gate to gate guest house
-    graph.addEdge(135, 136, 47); // Girls hostel main gate
-    graph.addEdge(136, 137, 12); // Girls hostel entrance gate
-    graph.addEdge(136, 138, 27); // Temple
-    graph.addEdge(115, 139, 10); // 2nd gate of fire station
-    graph.addEdge(97, 140, 29);  // Towards Gandhi Chowk
-    graph.addEdge(140, 141, 22); // Towards Gandhi Chowk
-    graph.addEdge(141, 142, 6);  // Towards amphitheater
-    graph.addEdge(141, 143, 10); // Gandhi Chowk
-    graph.addEdge(143, 22, 11);  // Towards other block
-    graph.addEdge(141, 144, 17); // Towards 9th block
-    graph.addEdge(141, 145, 10); // Towards body hostel
-    graph.addEdge(145, 146, 38); // Towards play school
-    graph.addEdge(146, 147, 5);  // Entrance of play school
-    graph.addEdge(146, 148, 14); // Front of canteen
-    graph.addEdge(148, 149, 12); // Gate of canteen
-    graph.addEdge(148, 150, 33); // Front of Tulip towards boys hotel 
-    graph.addEdge(150, 151, 4);  // Tulip 2nd gate towards boys hostel
-    graph.addEdge(150, 152, 23); // Front of laboratory
-    graph.addEdge(152, 153, 4);  // Gate of Laboratory
-    graph.addEdge(152, 154, 10); // Towards car gate of boys hostel
-    graph.addEdge(154, 155, 5);  // Car gate of boys hostel
-    graph.addEdge(154, 156, 6);  // Towards boys hostel entrance
-    graph.addEdge(156, 157, 6);  // Boys hostel gate
-    graph.addEdge(152, 159, 10); // Sitting area towards Tulip
-    graph.addEdge(159, 160, 18); // Front of Tulip
-    graph.addEdge(160, 161, 2);  // Towards Tulip 1st gate
-    graph.addEdge(161, 162, 4);  // 1st gate of Tulip
-    graph.addEdge(159, 163, 17); // Towards 11th block
-    graph.addEdge(163, 164, 3);  // Towards 11th block 1st gate
-    graph.addEdge(164, 165, 21); // 11th and 10th block
-    graph.addEdge(165, 166, 23); // Towards Gandhi Chowk 9th and 10th block
-    graph.addEdge(166, 167, 36); // Towards Gandhi Chowk 9th block
-    graph.addEdge(167, 168, 33); // Towards Gandhi Chowk 9th last gate
-    graph.addEdge(168, 184, 4);  // Towards play school
-    graph.addEdge(184, 185, 8);  // Towards amphitheater
-    graph.addEdge(185, 186, 13); // Towards 9th block
-    graph.addEdge(185, 24, 13);  // Towards 3rd block
-    graph.addEdge(186, 27, 4);   // Towards 9th block main entrance
-    graph.addEdge(186, 25, 12);  // Towards 3rd block
-    graph.addEdge(187, 167, 5);  // Mid gate of 9th block
-    graph.addEdge(188, 179, 4);  // Back gate stair of 9th block
-    graph.addEdge(179, 189, 8);  // Stair main gate of 10th block
-    graph.addEdge(189, 190, 3);  // Main gate of 10th block
-    graph.addEdge(188, 191, 8);  // Back gate of 9th block
-    graph.addEdge(191, 192, 34); // Towards mid of 9th block
-    graph.addEdge(192, 187, 11); // Mid gate of 9th block
-    graph.addEdge(192, 182, 31); // Front gate of 9th block
-    graph.addEdge(190, 193, 27); // Mid of 10th block
-    graph.addEdge(193, 176, 24); // End gate of 10th block
-    graph.addEdge(193, 194, 11); // Mid gate of 10th block
-    graph.addEdge(194, 195, 3);  // Between 11th and 10th block
-    graph.addEdge(195, 196, 5);  // Downside gate of 11th block
-    graph.addEdge(196, 197, 4);  // Towards 11th block stairs
-    graph.addEdge(197, 198, 6);  // Towards 11th block stairs
-    graph.addEdge(198, 199, 4);  // Towards 11th block stairs
-    graph.addEdge(199, 200, 20); // Towards 11th block main gate
-    graph.addEdge(200, 201, 4);  // Towards 11th block gate
-    graph.addEdge(201, 202, 1);  // Towards main gate of 11th block
-    graph.addEdge(202, 203, 3);  // Main gate of 11th block
-    graph.addEdge(202, 204, 12); // Towards intersection part
-    graph.addEdge(203, 205, 2);  // Towards main road
-    graph.addEdge(205, 164, 16); // 11th block main road
-    graph.addEdge(175, 195, 23); // Backroad of 11th and 10th block
-    graph.addEdge(165, 206, 19); // Main road towards mid of 11th and 10th block
-    graph.addEdge(206, 207, 3);  // Towards mid of 10th and 11th block
-    graph.addEdge(207, 195, 23); // Mid of 10th and 11th block
-    graph.addEdge(170, 204, 18); // Intersection point
-    graph.addEdge(170, 208, 17); // Towards 3rd gate of 11th block
-    graph.addEdge(170, 209, 19); // Mid gate of 11th block
-    graph.addEdge(208, 210, 8);  // Last gate to entrance
-    graph.addEdge(210, 211, 3);  // Last gate inside 11th block
-    graph.addEdge(211, 212, 8);  // Inside 11th block
-    graph.addEdge(212, 213, 25); // Inside 11th block
-    graph.addEdge(213, 214, 23); // Mid gate of 11th block
-    graph.addEdge(214, 209, 4);  // Mid gate entrance
-    graph.addEdge(214, 215, 25); // Towards main gate of 11th block
-    graph.addEdge(215, 199, 5);  // Towards stair of 11th block
-    graph.addEdge(30, 216, 6);   // Towards Frisco
-    graph.addEdge(216, 217, 4);  // Towards 3rd block
-    graph.addEdge(216, 218, 7);  // Towards Frisco
-    graph.addEdge(219, 31, 10);  // Towards 5th block
-    graph.addEdge(219, 220, 5);  // 5th block gate
-    graph.addEdge(219, 221, 7);  // Towards Frisco
-    graph.addEdge(221, 222, 6);  // Towards Frisco entrance
-    graph.addEdge(218, 222, 5);  // Towards Frisco entrance
-    graph.addEdge(222, 223, 3);  // Frisco entrance
-    graph.addEdge(218, 224, 16); //
-    graph.addEdge(221, 225, 16); //
-    graph.addEdge(218, 225, 18); 
-    graph.addEdge(224, 221, 18); //
-    graph.addEdge(224, 225, 12); //
-    graph.addEdge(225, 85, 16); 
-    graph.addEdge(224, 72, 15); //
-    graph.addEdge(225, 226, 29); //
-    graph.addEdge(226, 81, 5); 
-    graph.addEdge(226, 227, 8); //
-    graph.addEdge(227, 228, 6); //
-    graph.addEdge(228, 229, 4);
-    graph.addEdge(228, 224, 27); 
-    graph.addEdge(229, 76, 4);
-    graph.addEdge(228, 77, 4); 
-    graph.addEdge(227, 230, 3); 
-    graph.addEdge(231, 50, 12);
-    graph.addEdge(231, 48, 9);
-    
-    }
-    
-    else{
-        return 0;
-    }
-    aStar(graph, sourceNode, targetNode);
-
-    return 0;
-}
\ No newline at end of file
+#include "pathfinder.h"
+#include "pathfinder_internal.h"
+#include "pathfinder_server.h"
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <random>
+
+#include <map>
+#include <unordered_map>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <tuple>
+#include <fstream>
+#include <csignal>
+#include <cerrno>
+#include <atomic>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <dirent.h>
+#include <sys/eventfd.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PATHFINDER_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define PATHFINDER_X86_SIMD 0
+#endif
+
+using namespace std;
+
+// ... (include all the classes and functions from the original code)
+// Pack undirected edges {u, v, weight} the way addEdge followed by packArcs would:
+// each edge adds u -> v then v -> u, and every node's arcs are laid out newest first
+template <int N, class Edge, size_t E>
+constexpr StaticCsr<N, 2 * E> packEdges(const Edge (&edges)[E]) {
+    StaticCsr<N, 2 * E> csr{};
+    for (size_t i = 0; i < E; ++i) {
+        csr.arcs[2 * i] = Arc(edges[i].u, edges[i].v, edges[i].weight);
+        csr.arcs[2 * i + 1] = Arc(edges[i].v, edges[i].u, edges[i].weight);
+    }
+    for (const Arc& a : csr.arcs) {
+        csr.firstOut[a.from + 1]++;
+        csr.firstIn[a.to + 1]++;
+    }
+    for (int i = 0; i < N; ++i) {
+        csr.maxOutDegree = max(csr.maxOutDegree, csr.firstOut[i + 1]);
+        csr.firstOut[i + 1] += csr.firstOut[i];
+        csr.firstIn[i + 1] += csr.firstIn[i];
+    }
+    std::array<int, N> outPos{}, inPos{};
+    for (int i = 0; i < N; ++i) {
+        outPos[i] = csr.firstOut[i];
+        inPos[i] = csr.firstIn[i];
+    }
+    for (int i = 2 * E - 1; i >= 0; --i) {
+        const Arc& a = csr.arcs[i];
+        csr.head[outPos[a.from]] = a.to;
+        csr.outWeight[outPos[a.from]++] = a.weight;
+        csr.tail[inPos[a.to]] = a.from;
+        csr.inWeight[inPos[a.to]++] = a.weight;
+    }
+    return csr;
+}
+
+// Heuristic function: straight-line map distance times the cheapest cost per pixel
+// of any arc. It never overestimates, so A* returns shortest routes and agrees with
+// Dijkstra-based searches. Nodes without a map position get 0.
+int heuristic(Graph& graph, int node1, int node2) {
+    if (graph.x[node1] < 0 || graph.x[node2] < 0)
+        return 0;
+    double length = hypot(graph.x[node1] - graph.x[node2], graph.y[node1] - graph.y[node2]);
+    return (int)(length * graph.costPerPixel - 1e-9);
+}
+
+// ---------------------------------------------------------------------------
+// SIMD kernels. Each kernel has a scalar version and, on x86 with GCC/Clang, SSE4.1
+// and AVX2 versions compiled with target attributes. The widest one the CPU
+// supports is picked at runtime; PATHFINDER_SIMD=scalar|sse41|avx2 overrides it
+// with a level the CPU supports, and an unsupported or unknown level is ignored.
+// ---------------------------------------------------------------------------
+
+enum SimdLevel { SIMD_SCALAR, SIMD_SSE41, SIMD_AVX2 };
+
+SimdLevel detectSimdLevel() {
+    const char* forced = getenv("PATHFINDER_SIMD");
+    SimdLevel best = SIMD_SCALAR;
+#if PATHFINDER_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        best = SIMD_AVX2;
+    else if (__builtin_cpu_supports("sse4.1"))
+        best = SIMD_SSE41;
+#endif
+    if (forced != nullptr) {
+        string name = forced;
+        if (name == "scalar")
+            return SIMD_SCALAR;
+        if (name == "sse41" && best >= SIMD_SSE41)
+            return SIMD_SSE41;
+        if (name == "avx2" && best >= SIMD_AVX2)
+            return SIMD_AVX2;
+    }
+    return best;
+}
+
+SimdLevel simdLevel() {
+    static SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+const char* simdLevelName() {
+    static const char* const names[] = {"scalar", "sse41", "avx2"};
+    return names[simdLevel()];
+}
+
+// Relax the arcs [begin, end) out of a node settled at distance gu. Writes the
+// indices of the arcs whose candidate gu + weight beats g[head] to improved and
+// returns how many there are, in arc order. Callers re-check every hit before
+// applying it, because two arcs may lead to the same node.
+typedef int (*RelaxKernel)(const int* head, const int* weight, int begin, int end, int gu, const int* g, int* improved);
+
+int relaxArcsScalar(const int* head, const int* weight, int begin, int end, int gu, const int* g, int* improved) {
+    int hits = 0;
+    for (int e = begin; e < end; ++e) {
+        improved[hits] = e;
+        hits += gu + weight[e] < g[head[e]];
+    }
+    return hits;
+}
+
+#if PATHFINDER_X86_SIMD
+__attribute__((target("sse4.1")))
+int relaxArcsSse41(const int* head, const int* weight, int begin, int end, int gu, const int* g, int* improved) {
+    int hits = 0;
+    int e = begin;
+    __m128i base = _mm_set1_epi32(gu);
+    for (; e + 4 <= end; e += 4) {
+        // No gather before AVX2: load the four neighbour distances one by one
+        __m128i gv = _mm_set_epi32(g[head[e + 3]], g[head[e + 2]], g[head[e + 1]], g[head[e]]);
+        __m128i cand = _mm_add_epi32(base, _mm_loadu_si128((const __m128i*)(weight + e)));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(gv, cand)));
+        while (mask) {
+            improved[hits++] = e + __builtin_ctz(mask);
+            mask &= mask - 1;
+        }
+    }
+    return hits + relaxArcsScalar(head, weight, e, end, gu, g, improved + hits);
+}
+
+__attribute__((target("avx2")))
+int relaxArcsAvx2(const int* head, const int* weight, int begin, int end, int gu, const int* g, int* improved) {
+    int hits = 0;
+    int e = begin;
+    __m256i base = _mm256_set1_epi32(gu);
+    for (; e + 8 <= end; e += 8) {
+        __m256i idx = _mm256_loadu_si256((const __m256i*)(head + e));
+        __m256i gv = _mm256_i32gather_epi32(g, idx, 4);
+        __m256i cand = _mm256_add_epi32(base, _mm256_loadu_si256((const __m256i*)(weight + e)));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(gv, cand)));
+        while (mask) {
+            improved[hits++] = e + __builtin_ctz(mask);
+            mask &= mask - 1;
+        }
+    }
+    return hits + relaxArcsScalar(head, weight, e, end, gu, g, improved + hits);
+}
+#endif
+
+RelaxKernel relaxKernel() {
+#if PATHFINDER_X86_SIMD
+    if (simdLevel() == SIMD_AVX2)
+        return relaxArcsAvx2;
+    if (simdLevel() == SIMD_SSE41)
+        return relaxArcsSse41;
+#endif
+    return relaxArcsScalar;
+}
+
+// Lanes of the bulk search: one source per lane, eight 32-bit distances per node
+const int BULK_LANES = 8;
+const int BULK_INF = INT_MAX / 2;   // Unreached; small enough that adding a weight cannot overflow
+
+// Relax one arc for all lanes: to = min(to, from + weight). Returns the smallest
+// distance among the lanes that improved, or BULK_INF if none did.
+typedef int (*BulkRelaxKernel)(const int* from, int weight, int* to);
+
+int bulkRelaxScalar(const int* from, int weight, int* to) {
+    int best = BULK_INF;
+    for (int lane = 0; lane < BULK_LANES; ++lane) {
+        int cand = from[lane] + weight;
+        if (cand < to[lane]) {
+            to[lane] = cand;
+            best = min(best, cand);
+        }
+    }
+    return best;
+}
+
+#if PATHFINDER_X86_SIMD
+__attribute__((target("sse4.1")))
+int bulkRelaxSse41(const int* from, int weight, int* to) {
+    __m128i w = _mm_set1_epi32(weight);
+    __m128i inf = _mm_set1_epi32(BULK_INF);
+    __m128i best = inf;
+    for (int half = 0; half < BULK_LANES; half += 4) {
+        __m128i cand = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(from + half)), w);
+        __m128i cur = _mm_loadu_si128((const __m128i*)(to + half));
+        __m128i better = _mm_cmpgt_epi32(cur, cand);
+        if (_mm_testz_si128(better, better))
+            continue;
+        _mm_storeu_si128((__m128i*)(to + half), _mm_min_epi32(cur, cand));
+        best = _mm_min_epi32(best, _mm_blendv_epi8(inf, cand, better));
+    }
+    best = _mm_min_epi32(best, _mm_shuffle_epi32(best, _MM_SHUFFLE(1, 0, 3, 2)));
+    best = _mm_min_epi32(best, _mm_shuffle_epi32(best, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(best);
+}
+
+__attribute__((target("avx2")))
+int bulkRelaxAvx2(const int* from, int weight, int* to) {
+    __m256i cand = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)from), _mm256_set1_epi32(weight));
+    __m256i cur = _mm256_loadu_si256((const __m256i*)to);
+    __m256i better = _mm256_cmpgt_epi32(cur, cand);
+    if (_mm256_testz_si256(better, better))
+        return BULK_INF;
+    _mm256_storeu_si256((__m256i*)to, _mm256_min_epi32(cur, cand));
+    __m256i best = _mm256_blendv_epi8(_mm256_set1_epi32(BULK_INF), cand, better);
+    __m128i half = _mm_min_epi32(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1));
+    half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(half);
+}
+#endif
+
+BulkRelaxKernel bulkRelaxKernel() {
+#if PATHFINDER_X86_SIMD
+    if (simdLevel() == SIMD_AVX2)
+        return bulkRelaxAvx2;
+    if (simdLevel() == SIMD_SSE41)
+        return bulkRelaxSse41;
+#endif
+    return bulkRelaxScalar;
+}
+
+// One-to-all distances from many sources at once, for distance tables and
+// all-pairs use. Distances are over the base arc weights only: time-of-day
+// travel times, turn rules and accessibility avoidance are not applied. Sources are processed BULK_LANES at a time, one per SIMD lane,
+// in a label-correcting Dijkstra: a node is queued with the smallest distance
+// that improved in any lane and rescanned for all lanes when popped.
+// dist[i][v] is the distance from sources[i] to v, INT_MAX if unreachable.
+vector<vector<int>> bulkDistances(Graph& graph, const vector<int>& sources) {
+    int numNodes = graph.numNodes;
+    BulkRelaxKernel relax = bulkRelaxKernel();
+    vector<vector<int>> dist(sources.size(), vector<int>(numNodes, INT_MAX));
+    vector<int> lanes(numNodes * BULK_LANES);   // lanes[v * BULK_LANES + i]: distance of lane i to v
+    vector<int> queuedKey(numNodes);            // Key v is queued with, BULK_INF if it is not queued
+    graph.finalize();
+
+    for (size_t group = 0; group < sources.size(); group += BULK_LANES) {
+        fill(lanes.begin(), lanes.end(), BULK_INF);
+        fill(queuedKey.begin(), queuedKey.end(), BULK_INF);
+        MinHeap minHeap;
+
+        for (int lane = 0; lane < BULK_LANES && group + lane < sources.size(); ++lane) {
+            int s = sources[group + lane];
+            lanes[s * BULK_LANES + lane] = 0;
+            if (queuedKey[s] != 0) {
+                queuedKey[s] = 0;
+                minHeap.insert(MinHeapNode(s, 0));
+            }
+        }
+
+        while (!minHeap.isEmpty()) {
+            MinHeapNode top = minHeap.extractMin();
+            int u = top.v;
+            if (top.f != queuedKey[u])
+                continue;
+            queuedKey[u] = BULK_INF;
+
+            for (int e = graph.firstOut[u]; e < graph.firstOut[u + 1]; ++e) {
+                int v = graph.head[e];
+                int improved = relax(&lanes[u * BULK_LANES], graph.outWeight[e], &lanes[v * BULK_LANES]);
+                if (improved < queuedKey[v]) {
+                    queuedKey[v] = improved;
+                    minHeap.insert(MinHeapNode(v, improved));
+                }
+            }
+        }
+
+        for (int lane = 0; lane < BULK_LANES && group + lane < sources.size(); ++lane) {
+            for (int v = 0; v < numNodes; ++v) {
+                int d = lanes[v * BULK_LANES + lane];
+                dist[group + lane][v] = d >= BULK_INF ? INT_MAX : d;
+            }
+        }
+    }
+    return dist;
+}
+
+// Expansions between two reads of the cancel flag. Campus searches expand a few
+// hundred nodes, so a small interval lets preemption and disconnects take effect
+// there too; the relaxed load costs next to nothing.
+const int CANCEL_POLL_INTERVAL = 16;
+
+// True once the search should give up, called once per expansion
+bool searchStopped(SearchControl* control, long long& expansions) {
+    if (control == nullptr)
+        return false;
+    if (++expansions > control->maxExpansions && control->maxExpansions > 0) {
+        control->exhausted = true;
+        return true;
+    }
+    if (control->cancel == nullptr || expansions % CANCEL_POLL_INTERVAL != 0)
+        return false;
+    if (!control->cancel->load(memory_order_relaxed))
+        return false;
+    control->stopped = true;
+    return true;
+}
+
+// Heuristic h inflated to percent% for weighted A*
+int weightedHeuristic(int h, int percent) {
+    return percent == 100 ? h : (int)min<long long>(INT_MAX / 2, (long long)h * percent / 100);
+}
+
+// Time-dependent A*: labels are arrival times, and each arc costs its travel time
+// at the moment it is entered. The profiles are FIFO, so the first time a node is
+// settled is its earliest arrival, exactly as in static Dijkstra, and the static
+// heuristic stays a lower bound because profiles never go below 100%.
+// Returns the travel time from leaving src at `departure` (seconds after midnight).
+int timeDependentAStar(Graph& graph, int src, int target, int departure, vector<int>& parent,
+                       SearchControl* control = nullptr) {
+    int numNodes = graph.numNodes;
+    vector<int> arrival(numNodes, INT_MAX);
+    parent.assign(numNodes, -1);
+    MinHeap minHeap;
+    graph.finalize();
+    int percent = control ? control->heuristicPercent : 100;
+    long long bound = control ? control->upperBound : INT_MAX;
+    const uint64_t* blocked = graph.blockedOut[control ? control->avoid : 0].data();
+    long long expansions = 0;
+
+    arrival[src] = departure;
+    minHeap.insert(MinHeapNode(src, departure + weightedHeuristic(heuristic(graph, src, target), percent)));
+
+    while (!minHeap.isEmpty()) {
+        int u = minHeap.extractMin().v;
+
+        if (u == target)
+            return arrival[u] - departure;
+        if (searchStopped(control, expansions))
+            return INT_MAX;
+
+        for (int e = graph.firstOut[u]; e < graph.firstOut[u + 1]; ++e) {
+            int v = graph.head[e];
+            int reached = (arrival[u] + graph.arcTravelTime(e, arrival[u])) | blockedPenalty(blocked, e);
+            if (reached < arrival[v]) {
+                int h = heuristic(graph, v, target);
+                if ((long long)reached - departure + h > bound)
+                    continue;
+                arrival[v] = reached;
+                parent[v] = u;
+                minHeap.insert(MinHeapNode(v, reached + weightedHeuristic(h, percent)));
+            }
+        }
+    }
+    return INT_MAX;
+}
+
+// A* algorithm using custom min-heap over the CSR arcs
+// Returns the distance from src to target (INT_MAX if unreachable) and fills parent
+// with the search tree. Positions move with the nodes when the graph is renumbered,
+// so every node order finds the same route. Graphs with travel-time profiles are
+// searched by timeDependentAStar for the given departure time. control, if given,
+// selects weighted A*, a cost bound or cancellation (see SearchControl).
+int aStarSearch(Graph& graph, int src, int target, vector<int>& parent, int departure,
+                SearchControl* control) {
+    if (graph.timeDependent())
+        return timeDependentAStar(graph, src, target, departure, parent, control);
+    int numNodes = graph.numNodes;
+    vector<int> g(numNodes, INT_MAX);  // Cost from start to a node
+    parent.assign(numNodes, -1);       // To store the path
+    MinHeap minHeap;
+    graph.finalize();
+    RelaxKernel relax = relaxKernel();
+    vector<int> improved(graph.maxOutDegree);  // Arcs the kernel found to improve g
+    int percent = control ? control->heuristicPercent : 100;
+    long long bound = control ? control->upperBound : INT_MAX;
+    const uint64_t* blocked = graph.blockedOut[control ? control->avoid : 0].data();
+    long long expansions = 0;
+
+    g[src] = 0;
+    minHeap.insert(MinHeapNode(src, weightedHeuristic(heuristic(graph, src, target), percent)));
+
+    while (!minHeap.isEmpty()) {
+        int u = minHeap.extractMin().v;
+
+        if (u == target)
+            return g[u];
+        if (searchStopped(control, expansions))
+            return INT_MAX;
+
+        int hits = relax(graph.head.data(), graph.outWeight.data(), graph.firstOut[u], graph.firstOut[u + 1],
+                         g[u], g.data(), improved.data());
+        for (int i = 0; i < hits; ++i) {
+            int e = improved[i];
+            int v = graph.head[e];
+            int reached = (g[u] + graph.outWeight[e]) | blockedPenalty(blocked, e);
+
+            if (reached < g[v]) {
+                int h = heuristic(graph, v, target);
+                if ((long long)reached + h > bound)
+                    continue;
+                g[v] = reached;
+                parent[v] = u;
+                minHeap.insert(MinHeapNode(v, g[v] + weightedHeuristic(h, percent)));  // f = g + h
+            }
+        }
+    }
+    return INT_MAX;
+}
+
+// Dijkstra from src that stops once every target is settled, so one sweep answers
+// all queries that share a source. dist and parent describe the search tree;
+// dist[t] stays INT_MAX for unreachable targets. Arcs cost their travel time when
+// entered, leaving src at `departure`; that is the plain weight on static graphs.
+// When control stops the sweep early, targets not settled yet are left at INT_MAX.
+void oneToManySearch(Graph& graph, int src, const vector<int>& targets, vector<int>& dist, vector<int>& parent,
+                     int departure = 0, SearchControl* control = nullptr) {
+    int numNodes = graph.numNodes;
+    dist.assign(numNodes, INT_MAX);
+    parent.assign(numNodes, -1);
+    vector<bool> settled(numNodes, false);
+    vector<bool> wanted(numNodes, false);
+    MinHeap minHeap;
+    graph.finalize();
+
+    int remaining = 0;
+    for (int t : targets) {
+        if (!wanted[t]) {
+            wanted[t] = true;
+            remaining++;
+        }
+    }
+    long long expansions = 0;
+    const uint64_t* blocked = graph.blockedOut[control ? control->avoid : 0].data();
+
+    dist[src] = 0;
+    minHeap.insert(MinHeapNode(src, 0));
+    while (!minHeap.isEmpty() && remaining > 0) {
+        int u = minHeap.extractMin().v;
+        if (settled[u])
+            continue;
+        settled[u] = true;
+        if (wanted[u])
+            remaining--;
+        if (remaining > 0 && searchStopped(control, expansions)) {
+            for (int t : targets) {
+                if (!settled[t])
+                    dist[t] = INT_MAX;
+            }
+            return;
+        }
+
+        for (int e = graph.firstOut[u]; e < graph.firstOut[u + 1]; ++e) {
+            int v = graph.head[e];
+            int reached = (dist[u] + graph.arcTravelTime(e, departure + dist[u])) | blockedPenalty(blocked, e);
+            if (!settled[v] && reached < dist[v]) {
+                dist[v] = reached;
+                parent[v] = u;
+                minHeap.insert(MinHeapNode(v, dist[v]));
+            }
+        }
+    }
+}
+
+// Distances between every pair of nodes, leaving each source at `departure` and
+// avoiding the accessibility features in avoid: dist[i][v] is the travel time from
+// nodes[i] to v, INT_MAX if unreachable. Static graphs without avoidance take the
+// SIMD bulk search; travel-time profiles and avoidance need one time-dependent
+// sweep per source. Turns are not modelled.
+vector<vector<int>> distanceMatrix(Graph& graph, const vector<int>& nodes, int departure, int avoid) {
+    graph.finalize();
+    if (!graph.timeDependent() && avoid == 0)
+        return bulkDistances(graph, nodes);
+    vector<vector<int>> dist(nodes.size());
+    vector<int> parent;
+    SearchControl control;
+    control.avoid = avoid;
+    for (size_t i = 0; i < nodes.size(); ++i)
+        oneToManySearch(graph, nodes[i], nodes, dist[i], parent, departure, &control);
+    return dist;
+}
+
+// Turn-aware A* for graphs with turns modelled. The search runs over arcs instead of
+// nodes (an edge-based graph, expanded implicitly): the label of arc u -> v is the
+// arrival time at v having come from u, and moving on to arc v -> w adds the cost
+// of the turn u -> v -> w. Labels live in one array indexed by CSR arc, so memory
+// is one int per arc and nothing is materialized. parentArc receives the arc tree
+// and lastArc the arc that reaches target (-1 when src == target).
+int turnAwareSearch(Graph& graph, int src, int target, int departure, vector<int>& parentArc, int& lastArc,
+                    SearchControl* control) {
+    graph.finalize();
+    int numArcs = graph.head.size();
+    vector<int> arrival(numArcs, INT_MAX);
+    vector<bool> settled(numArcs, false);
+    parentArc.assign(numArcs, -1);
+    MinHeap minHeap;
+    lastArc = -1;
+    if (src == target)
+        return 0;
+    int percent = control ? control->heuristicPercent : 100;
+    long long bound = control ? control->upperBound : INT_MAX;
+    const uint64_t* blocked = graph.blockedOut[control ? control->avoid : 0].data();
+    long long expansions = 0;
+
+    for (int e = graph.firstOut[src]; e < graph.firstOut[src + 1]; ++e) {
+        if (blockedPenalty(blocked, e))
+            continue;
+        arrival[e] = departure + graph.arcTravelTime(e, departure);
+        minHeap.insert(MinHeapNode(e, arrival[e] + weightedHeuristic(heuristic(graph, graph.head[e], target), percent)));
+    }
+
+    while (!minHeap.isEmpty()) {
+        int e = minHeap.extractMin().v;
+        if (settled[e])
+            continue;
+        settled[e] = true;
+
+        int v = graph.head[e];
+        if (v == target) {
+            lastArc = e;
+            return arrival[e] - departure;
+        }
+        if (searchStopped(control, expansions))
+            return INT_MAX;
+        int u = parentArc[e] < 0 ? src : graph.head[parentArc[e]];
+
+        for (int next = graph.firstOut[v]; next < graph.firstOut[v + 1]; ++next) {
+            int turn = graph.turnCost(u, v, graph.head[next]);
+            if (turn == TURN_FORBIDDEN || settled[next])
+                continue;
+            int leave = arrival[e] + turn;
+            int reached = (leave + graph.arcTravelTime(next, leave)) | blockedPenalty(blocked, next);
+            if (reached < arrival[next]) {
+                int h = heuristic(graph, graph.head[next], target);
+                if ((long long)reached - departure + h > bound)
+                    continue;
+                arrival[next] = reached;
+                parentArc[next] = e;
+                minHeap.insert(MinHeapNode(next, reached + weightedHeuristic(h, percent)));
+            }
+        }
+    }
+    return INT_MAX;
+}
+
+// Result of a nearest-facility query
+class FacilityMatch {
+public:
+    int node;
+    int distance;
+    FacilityMatch(int n, int d) : node(n), distance(d) {}
+};
+
+// k nearest facilities of a category from src, found with a single Dijkstra that
+// stops as soon as k tagged nodes are settled. parent receives the search tree so
+// the route to every match can be printed. Arcs cost their travel time leaving src
+// at `departure`; arcs with an accessibility feature in avoid are not taken.
+// bound, when given, is a FacilityIndex distance table for the category and avoid
+// mask: a lower bound on every node's distance to its closest facility. The search
+// then runs as A* towards the facilities and never enters nodes that reach none.
+// control adds a budget or cancellation; a search that stops early returns the
+// matches settled so far, which are still the closest ones.
+vector<FacilityMatch> nearestFacilities(Graph& graph, int src, Facility category, int k, vector<int>& parent,
+                                        int departure = 0, int avoid = 0, const int* bound = nullptr,
+                                        SearchControl* control = nullptr) {
+    int numNodes = graph.numNodes;
+    vector<int> dist(numNodes, INT_MAX);
+    vector<bool> settled(numNodes, false);
+    vector<FacilityMatch> matches;
+    MinHeap minHeap;
+    parent.assign(numNodes, -1);
+    graph.finalize();
+
+    int tagged = graph.facilityNodes[Graph::facilityIndex(category)].size();
+    int wanted = min(k, tagged);
+    if (wanted <= 0)
+        return matches;
+
+    const uint64_t* blocked = graph.blockedOut[avoid].data();
+    if (bound && bound[src] == INT_MAX)
+        return matches;
+
+    dist[src] = 0;
+    minHeap.insert(MinHeapNode(src, bound ? bound[src] : 0));
+    long long expansions = 0;
+
+    while (!minHeap.isEmpty() && (int)matches.size() < wanted) {
+        int u = minHeap.extractMin().v;
+        if (settled[u])
+            continue;
+        settled[u] = true;
+        if (searchStopped(control, expansions))
+            break;
+
+        if (graph.facilities[u] & category)
+            matches.push_back(FacilityMatch(u, dist[u]));
+
+        for (int e = graph.firstOut[u]; e < graph.firstOut[u + 1]; ++e) {
+            int v = graph.head[e];
+            int reached = (dist[u] + graph.arcTravelTime(e, departure + dist[u])) | blockedPenalty(blocked, e);
+            if (!settled[v] && reached < dist[v]) {
+                if (bound && bound[v] == INT_MAX)
+                    continue;
+                dist[v] = reached;
+                parent[v] = u;
+                minHeap.insert(MinHeapNode(v, dist[v] + (bound ? bound[v] : 0)));
+            }
+        }
+    }
+    return matches;
+}
+
+// nearestFacilities for graphs with turns modelled: the arc-based search of
+// turnAwareSearch without a target, which stops once k tagged nodes have been
+// reached, so matches obey the turn rules and their distances include turn
+// costs. lastArc[i] is the arc that reaches matches[i] (-1 for src itself); the
+// route is read back through parentArc. bound and control are used as in
+// nearestFacilities.
+vector<FacilityMatch> turnAwareNearestFacilities(Graph& graph, int src, Facility category, int k,
+                                                 vector<int>& parentArc, vector<int>& lastArc,
+                                                 int departure = 0, int avoid = 0, const int* bound = nullptr,
+                                                 SearchControl* control = nullptr) {
+    graph.finalize();
+    int numArcs = graph.head.size();
+    vector<int> arrival(numArcs, INT_MAX);
+    vector<bool> settled(numArcs, false), found(graph.numNodes, false);
+    vector<FacilityMatch> matches;
+    MinHeap minHeap;
+    parentArc.assign(numArcs, -1);
+    lastArc.clear();
+
+    int tagged = graph.facilityNodes[Graph::facilityIndex(category)].size();
+    int wanted = min(k, tagged);
+    if (wanted <= 0)
+        return matches;
+    const uint64_t* blocked = graph.blockedOut[avoid].data();
+
+    if (graph.facilities[src] & category) {
+        found[src] = true;
+        matches.push_back(FacilityMatch(src, 0));
+        lastArc.push_back(-1);
+    }
+    for (int e = graph.firstOut[src]; e < graph.firstOut[src + 1]; ++e) {
+        if (blockedPenalty(blocked, e) || (bound && bound[graph.head[e]] == INT_MAX))
+            continue;
+        arrival[e] = departure + graph.arcTravelTime(e, departure);
+        minHeap.insert(MinHeapNode(e, arrival[e] + (bound ? bound[graph.head[e]] : 0)));
+    }
+    long long expansions = 0;
+
+    while (!minHeap.isEmpty() && (int)matches.size() < wanted) {
+        int e = minHeap.extractMin().v;
+        if (settled[e])
+            continue;
+        settled[e] = true;
+        if (searchStopped(control, expansions))
+            break;
+
+        // The first settled arc into a node reaches it earliest
+        int v = graph.head[e];
+        if (!found[v] && (graph.facilities[v] & category)) {
+            found[v] = true;
+            matches.push_back(FacilityMatch(v, arrival[e] - departure));
+            lastArc.push_back(e);
+        }
+        int u = parentArc[e] < 0 ? src : graph.head[parentArc[e]];
+
+        for (int next = graph.firstOut[v]; next < graph.firstOut[v + 1]; ++next) {
+            int turn = graph.turnCost(u, v, graph.head[next]);
+            if (turn == TURN_FORBIDDEN || settled[next])
+                continue;
+            int leave = arrival[e] + turn;
+            int reached = (leave + graph.arcTravelTime(next, leave)) | blockedPenalty(blocked, next);
+            if (reached < arrival[next]) {
+                int h = bound ? bound[graph.head[next]] : 0;
+                if (h == INT_MAX)
+                    continue;
+                arrival[next] = reached;
+                parentArc[next] = e;
+                minHeap.insert(MinHeapNode(next, reached + h));
+            }
+        }
+    }
+    return matches;
+}
+
+// Per-category nearest-facility tables for long-running processes. Each table is
+// one multi-source Dijkstra over the reverse arcs, seeded with every tagged node at
+// distance 0, so distances are measured from a node towards its facility even on
+// one-way or asymmetric edges. Tables are rebuilt lazily the first time they are
+// read after the graph version changes. A reverse search has no departure time, so
+// the tables use the base arc weights without time-of-day costs. Travel times never
+// fall below the base weight and turn costs only add to it, so on other graphs the
+// distances are lower bounds that steer the exact searches. An index built with
+// accessibility features to avoid serves queries that avoid exactly those.
+class FacilityIndex {
+public:
+    Graph& graph;
+    int avoid;                          // Accessibility features the tables' routes avoid
+    vector<int> builtVersion;           // Graph version each category table was built for
+    vector<vector<int>> nearest;        // nearest[c][v]: closest facility of category c, -1 if unreachable
+    vector<vector<int>> distance;       // distance[c][v]: distance from v to nearest[c][v]
+    vector<vector<int>> nextHop;        // nextHop[c][v]: next node on the way from v to nearest[c][v]
+
+    FacilityIndex(Graph& g, int avoidFeatures = 0) : graph(g), avoid(avoidFeatures) {
+        builtVersion.resize(NUM_FACILITY_CATEGORIES, -1);
+        nearest.resize(NUM_FACILITY_CATEGORIES);
+        distance.resize(NUM_FACILITY_CATEGORIES);
+        nextHop.resize(NUM_FACILITY_CATEGORIES);
+    }
+
+    // Refresh the table of one category if the graph changed since it was built
+    void refresh(Facility category) {
+        int c = Graph::facilityIndex(category);
+        if (builtVersion[c] == graph.version)
+            return;
+
+        int numNodes = graph.numNodes;
+        graph.finalize();
+        nearest[c].assign(numNodes, -1);
+        distance[c].assign(numNodes, INT_MAX);
+        nextHop[c].assign(numNodes, -1);
+        vector<bool> settled(numNodes, false);
+        MinHeap minHeap;
+        const uint64_t* blocked = graph.blockedIn[avoid].data();
+
+        for (int node : graph.facilityNodes[c]) {
+            nearest[c][node] = node;
+            distance[c][node] = 0;
+            minHeap.insert(MinHeapNode(node, 0));
+        }
+
+        while (!minHeap.isEmpty()) {
+            int u = minHeap.extractMin().v;
+            if (settled[u])
+                continue;
+            settled[u] = true;
+
+            for (int e = graph.firstIn[u]; e < graph.firstIn[u + 1]; ++e) {
+                int v = graph.tail[e];
+                int reached = (distance[c][u] + graph.inWeight[e]) | blockedPenalty(blocked, e);
+                if (!settled[v] && reached < distance[c][v]) {
+                    distance[c][v] = reached;
+                    nearest[c][v] = nearest[c][u];
+                    nextHop[c][v] = u;
+                    minHeap.insert(MinHeapNode(v, distance[c][v]));
+                }
+            }
+        }
+        builtVersion[c] = graph.version;
+    }
+
+    // Closest facility of a category from node, -1 if none is reachable
+    int nearestTo(int node, Facility category) {
+        refresh(category);
+        return nearest[Graph::facilityIndex(category)][node];
+    }
+};
+
+// Map a category name used on the command line to its facility flag
+bool parseFacility(const string& name, Facility& category) {
+    if (name == "washroom")
+        category = FACILITY_WASHROOM;
+    else if (name == "exit")
+        category = FACILITY_EXIT_GATE;
+    else if (name == "medical")
+        category = FACILITY_MEDICAL;
+    else if (name == "food")
+        category = FACILITY_FOOD;
+    else
+        return false;
+    return true;
+}
+
+// Features to avoid for an access need
+bool parseAccessNeed(const string& name, int& avoid) {
+    if (name == "any")
+        avoid = 0;
+    else if (name == "wheelchair")
+        avoid = ACCESS_STAIRS;
+    else
+        return false;
+    return true;
+}
+
+// Facility tags taken from the survey notes on the campus edges
+// No medical room has been surveyed yet, so FACILITY_MEDICAL has no nodes
+void tagCampusFacilities(Graph& graph) {
+    graph.tagFacility(56, FACILITY_WASHROOM);   // Front of wash room, 1st block
+    graph.tagFacility(0, FACILITY_EXIT_GATE);   // Main Gate
+    graph.tagFacility(35, FACILITY_FOOD);       // Main gate of food court
+    graph.tagFacility(149, FACILITY_FOOD);      // Gate of canteen
+}
+
+// Static 2-d tree over the positioned nodes of one graph snapshot, used to snap
+// map clicks to the graph. Only nodes that have edges in the snapshot are indexed,
+// and the tree is rebuilt lazily when the graph version changes.
+class SpatialIndex {
+public:
+    Graph& graph;
+    int builtVersion;
+    vector<int> tree;   // Node ids as an implicit balanced k-d tree: the median of [lo, hi) sits at the middle
+
+    SpatialIndex(Graph& g) : graph(g), builtVersion(-1) {}
+
+    void refresh() {
+        if (builtVersion == graph.version)
+            return;
+        graph.finalize();
+        tree.clear();
+        for (int v = 0; v < graph.numNodes; ++v) {
+            if (graph.x[v] >= 0 && graph.hasArcs(v))
+                tree.push_back(v);
+        }
+        build(0, tree.size(), 0);
+        builtVersion = graph.version;
+    }
+
+    // Nearest indexed node to (px, py), -1 if the graph has no positioned nodes
+    int nearestNode(int px, int py) {
+        vector<int> nodes = nearestNodes(px, py, 1);
+        return nodes.empty() ? -1 : nodes[0];
+    }
+
+    // k nearest indexed nodes to (px, py), closest first
+    vector<int> nearestNodes(int px, int py, int k) {
+        refresh();
+        vector<pair<long long, int>> best;  // Max-heap of the k best (squared distance, node)
+        search(0, tree.size(), 0, px, py, k, best);
+        sort_heap(best.begin(), best.end());
+        vector<int> nodes;
+        for (auto& b : best)
+            nodes.push_back(b.second);
+        return nodes;
+    }
+
+    // Snap (px, py) onto the closest edge among those touching the nearest nodes and
+    // return the edge endpoint nearer to the projected point. A click in the middle of
+    // a long road starts from that road instead of an unrelated node that happens to
+    // be a little closer.
+    int snapPoint(int px, int py) {
+        const int CANDIDATES = 4;
+        int bestNode = -1;
+        double bestDist = 0;
+        for (int u : nearestNodes(px, py, CANDIDATES)) {
+            // Leaving and entering arcs, so one-way roads can be snapped to as well
+            vector<int> around(graph.head.begin() + graph.firstOut[u], graph.head.begin() + graph.firstOut[u + 1]);
+            around.insert(around.end(), graph.tail.begin() + graph.firstIn[u], graph.tail.begin() + graph.firstIn[u + 1]);
+            for (int v : around) {
+                if (graph.x[v] < 0)
+                    continue;
+                double dx = graph.x[v] - graph.x[u], dy = graph.y[v] - graph.y[u];
+                double len2 = dx * dx + dy * dy;
+                double t = len2 > 0 ? ((px - graph.x[u]) * dx + (py - graph.y[u]) * dy) / len2 : 0;
+                t = max(0.0, min(1.0, t));
+                double ex = graph.x[u] + t * dx - px, ey = graph.y[u] + t * dy - py;
+                double d = ex * ex + ey * ey;
+                if (bestNode == -1 || d < bestDist) {
+                    bestDist = d;
+                    bestNode = t <= 0.5 ? u : v;
+                }
+            }
+        }
+        return bestNode;
+    }
+
+private:
+    void build(int lo, int hi, int depth) {
+        if (hi - lo <= 1)
+            return;
+        int mid = (lo + hi) / 2;
+        vector<int>& xs = depth % 2 == 0 ? graph.x : graph.y;
+        nth_element(tree.begin() + lo, tree.begin() + mid, tree.begin() + hi,
+                    [&](int a, int b) { return xs[a] < xs[b]; });
+        build(lo, mid, depth + 1);
+        build(mid + 1, hi, depth + 1);
+    }
+
+    void search(int lo, int hi, int depth, int px, int py, int k, vector<pair<long long, int>>& best) {
+        if (lo >= hi)
+            return;
+        int mid = (lo + hi) / 2;
+        int node = tree[mid];
+        long long dx = graph.x[node] - px, dy = graph.y[node] - py;
+        long long d = dx * dx + dy * dy;
+        if ((int)best.size() < k) {
+            best.push_back(make_pair(d, node));
+            push_heap(best.begin(), best.end());
+        } else if (d < best.front().first) {
+            pop_heap(best.begin(), best.end());
+            best.back() = make_pair(d, node);
+            push_heap(best.begin(), best.end());
+        }
+
+        long long split = depth % 2 == 0 ? dx : dy;  // Signed offset of the node from the query on this axis
+        int nearLo = split > 0 ? lo : mid + 1, nearHi = split > 0 ? mid : hi;
+        int farLo = split > 0 ? mid + 1 : lo, farHi = split > 0 ? hi : mid;
+        search(nearLo, nearHi, depth + 1, px, py, k, best);
+        if ((int)best.size() < k || split * split < best.front().first)
+            search(farLo, farHi, depth + 1, px, py, k, best);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Node orderings for Graph::renumber. Each returns newId[v] for every node.
+// Survey order scatters neighbours across the id space; these orders put nodes
+// that are searched together next to each other in g, parent and the CSR arrays.
+// ---------------------------------------------------------------------------
+
+// Neighbours in either direction, so one-way arcs still count as adjacent
+vector<int> undirectedNeighbours(Graph& graph, int u) {
+    vector<int> around(graph.head.begin() + graph.firstOut[u], graph.head.begin() + graph.firstOut[u + 1]);
+    around.insert(around.end(), graph.tail.begin() + graph.firstIn[u], graph.tail.begin() + graph.firstIn[u + 1]);
+    return around;
+}
+
+// Breadth-first order from `start`, appending to order. With degree given,
+// neighbours are visited by increasing degree (Cuthill-McKee), otherwise in arc order.
+void bfsVisit(Graph& graph, int start, const vector<int>* degree, vector<bool>& visited, vector<int>& order) {
+    size_t front = order.size();
+    visited[start] = true;
+    order.push_back(start);
+    while (front < order.size()) {
+        int u = order[front++];
+        vector<int> around = undirectedNeighbours(graph, u);
+        if (degree != nullptr) {
+            stable_sort(around.begin(), around.end(), [&](int a, int b) { return (*degree)[a] < (*degree)[b]; });
+        }
+        for (int v : around) {
+            if (!visited[v]) {
+                visited[v] = true;
+                order.push_back(v);
+            }
+        }
+    }
+}
+
+vector<int> orderToNewId(const vector<int>& order) {
+    vector<int> newId(order.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        newId[order[i]] = i;
+    return newId;
+}
+
+// Plain BFS order, one component after another
+vector<int> bfsOrder(Graph& graph) {
+    graph.finalize();
+    vector<bool> visited(graph.numNodes, false);
+    vector<int> order;
+    for (int v = 0; v < graph.numNodes; ++v) {
+        if (!visited[v])
+            bfsVisit(graph, v, nullptr, visited, order);
+    }
+    return orderToNewId(order);
+}
+
+// Reverse Cuthill-McKee: BFS by increasing degree from a pseudo-peripheral node of
+// each component (found by repeating BFS from the last node reached), reversed
+vector<int> rcmOrder(Graph& graph) {
+    graph.finalize();
+    vector<bool> visited(graph.numNodes, false);
+    vector<int> order;
+    vector<int> degree(graph.numNodes);
+    for (int v = 0; v < graph.numNodes; ++v)
+        degree[v] = undirectedNeighbours(graph, v).size();
+    for (int v = 0; v < graph.numNodes; ++v) {
+        if (visited[v])
+            continue;
+        int start = v;
+        for (int sweep = 0; sweep < 2; ++sweep) {
+            vector<bool> seen(visited);
+            vector<int> probe;
+            bfsVisit(graph, start, nullptr, seen, probe);
+            start = probe.back();
+        }
+        bfsVisit(graph, start, &degree, visited, order);
+    }
+    reverse(order.begin(), order.end());
+    return orderToNewId(order);
+}
+
+// Position of (px, py) along a Hilbert curve over a side x side grid (side a power of two)
+long long hilbertIndex(int side, int px, int py) {
+    long long d = 0;
+    for (int s = side / 2; s > 0; s /= 2) {
+        int rx = (px & s) > 0;
+        int ry = (py & s) > 0;
+        d += (long long)s * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                px = side - 1 - px;
+                py = side - 1 - py;
+            }
+            swap(px, py);
+        }
+    }
+    return d;
+}
+
+// Hilbert curve order over the map positions; nodes without a position go last
+vector<int> hilbertOrder(Graph& graph) {
+    int side = 1;
+    for (int v = 0; v < graph.numNodes; ++v) {
+        while (side <= max(graph.x[v], graph.y[v]))
+            side *= 2;
+    }
+    vector<long long> key(graph.numNodes);
+    for (int v = 0; v < graph.numNodes; ++v)
+        key[v] = graph.x[v] >= 0 ? hilbertIndex(side, graph.x[v], graph.y[v]) : LLONG_MAX;
+    vector<int> order(graph.numNodes);
+    for (int v = 0; v < graph.numNodes; ++v)
+        order[v] = v;
+    stable_sort(order.begin(), order.end(), [&](int a, int b) { return key[a] < key[b]; });
+    return orderToNewId(order);
+}
+
+// Names of the node orders applyNodeOrder accepts
+bool knownNodeOrder(const string& name) {
+    return name == "none" || name == "bfs" || name == "rcm" || name == "hilbert";
+}
+
+// Renumber the graph with a named order: none, bfs, rcm or hilbert
+bool applyNodeOrder(Graph& graph, const string& name) {
+    if (name == "none")
+        return true;
+    if (name == "bfs")
+        graph.renumber(bfsOrder(graph));
+    else if (name == "rcm")
+        graph.renumber(rcmOrder(graph));
+    else if (name == "hilbert")
+        graph.renumber(hilbertOrder(graph));
+    else
+        return false;
+    return true;
+}
+
+// Pixel positions of the surveyed nodes on public/map.jpg: {node, x, y}
+const int campusPositions[][3] = {
+    {0, 1397, 955}, {1, 1326, 881}, {2, 1269, 913}, {3, 1142, 931}, {4, 1082, 948}, {5, 1082, 977},
+    {6, 986, 963}, {7, 919, 970}, {8, 919, 1015}, {9, 919, 1041}, {10, 873, 970}, {11, 857, 1006},
+    {12, 821, 985}, {13, 840, 933}, {14, 840, 898}, {15, 840, 873}, {16, 840, 798}, {17, 840, 753},
+    {18, 840, 708}, {19, 840, 645}, {20, 840, 619}, {21, 840, 593}, {22, 866, 567}, {23, 862, 537},
+    {24, 903, 552}, {25, 948, 552}, {26, 955, 575}, {27, 955, 492}, {28, 1015, 554},
+    {29, 1042, 554}, {30, 1066, 554}, {31, 1089, 554}, {32, 1091, 575}, {33, 1173, 560},
+    {34, 1173, 606}, {35, 1209, 614}, {36, 1204, 604}, {37, 1173, 634}, {38, 1173, 660},
+    {39, 1198, 658}, {40, 1209, 658}, {41, 1209, 697}, {42, 1299, 693}, {43, 1291, 753},
+    {44, 1320, 776}, {45, 1336, 791}, {46, 1266, 851}, {47, 1206, 848}, {48, 1207, 833},
+    {49, 1148, 848}, {50, 1143, 818}, {51, 1135, 818}, {52, 1148, 723}, {53, 1173, 723},
+    {54, 1118, 818}, {55, 1120, 846}, {56, 1090, 818}, {57, 1090, 768}, {58, 986, 768},
+    {59, 983, 813}, {60, 956, 813}, {61, 941, 818}, {62, 948, 843}, {63, 895, 813}, {64, 895, 933},
+    {65, 895, 791}, {66, 895, 634}, {67, 895, 612}, {68, 1307, 645}, {69, 1282, 643},
+    {70, 1275, 657}, {71, 1275, 614}, {72, 975, 634}, {73, 975, 621}, {74, 975, 657},
+    {75, 970, 697}, {76, 982, 697}, {77, 982, 713}, {78, 982, 730}, {79, 949, 731}, {80, 1099, 739},
+    {81, 1099, 723}, {82, 1099, 702}, {83, 1125, 702}, {84, 1125, 664}, {85, 1125, 644},
+    {86, 1125, 627}, {87, 1126, 585}, {88, 1091, 585}, {89, 665, 746}, {90, 665, 723},
+    {91, 665, 761}, {92, 665, 706}, {93, 717, 723}, {94, 714, 671}, {95, 601, 671}, {96, 601, 642},
+    {97, 597, 530}, {98, 627, 642}, {99, 601, 716}, {100, 601, 750}, {101, 601, 858},
+    {102, 698, 858}, {103, 702, 895}, {104, 702, 928}, {105, 702, 1021}, {106, 589, 1015},
+    {107, 589, 1030}, {108, 562, 1000}, {109, 486, 1000}, {110, 478, 888}, {111, 456, 888},
+    {112, 437, 888}, {113, 739, 888}, {114, 783, 888}, {115, 486, 522}, {116, 486, 578},
+    {117, 431, 522}, {118, 434, 702}, {119, 404, 701}, {120, 415, 903}, {121, 437, 956},
+    {122, 431, 1057}, {123, 307, 1057}, {124, 151, 1049}, {125, 151, 643}, {126, 225, 646},
+    {127, 225, 590}, {128, 315, 590}, {129, 344, 691}, {130, 373, 694}, {131, 336, 515},
+    {132, 307, 530}, {133, 225, 522}, {134, 434, 470}, {135, 321, 478}, {136, 280, 385},
+    {137, 276, 343}, {138, 362, 403}, {139, 494, 470}, {140, 710, 522}, {141, 776, 519},
+    {142, 783, 575}, {143, 813, 545}, {144, 851, 473}, {145, 800, 463}, {146, 797, 373},
+    {147, 816, 373}, {148, 797, 326}, {149, 698, 322}, {150, 797, 291}, {151, 815, 298},
+    {152, 797, 201}, {153, 783, 178}, {154, 726, 201}, {155, 698, 201}, {156, 726, 172},
+    {157, 695, 172}, {159, 832, 201}, {160, 830, 266}, {161, 846, 266}, {162, 846, 291},
+    {163, 873, 209}, {164, 873, 231}, {165, 873, 269}, {166, 873, 370}, {167, 873, 425},
+    {168, 873, 463}, {169, 873, 186}, {170, 938, 190}, {171, 879, 97}, {172, 793, 75},
+    {173, 793, 89}, {174, 1121, 119}, {175, 1121, 258}, {176, 1125, 313}, {177, 1125, 370},
+    {178, 1043, 370}, {179, 933, 370}, {180, 1045, 470}, {181, 1027, 463}, {182, 958, 463},
+    {183, 909, 470}, {184, 896, 485}, {185, 896, 507}, {186, 949, 515}, {187, 905, 425},
+    {188, 936, 385}, {189, 926, 328}, {190, 942, 325}, {191, 962, 388}, {192, 958, 429},
+    {193, 1022, 322}, {194, 1027, 276}, {195, 1022, 258}, {196, 1022, 245}, {197, 1022, 233},
+    {198, 1048, 229}, {199, 1049, 237}, {200, 955, 230}, {201, 957, 241}, {202, 947, 241},
+    {203, 937, 236}, {204, 945, 213}, {205, 933, 245}, {206, 938, 268}, {207, 940, 257},
+    {208, 942, 170}, {209, 975, 188}, {210, 942, 151}, {211, 958, 151}, {212, 958, 166},
+    {213, 1054, 155}, {214, 1054, 190}, {215, 1065, 233}, {216, 1019, 585}, {217, 1005, 585},
+    {218, 1015, 611}, {219, 1050, 582}, {220, 1062, 585}, {221, 1060, 611}, {222, 1039, 611},
+    {223, 1039, 604}, {224, 1015, 632}, {225, 1060, 634}, {226, 1060, 716}, {227, 1033, 716},
+    {228, 1015, 716}, {229, 1008, 702}, {230, 1037, 724}, {231, 1207, 813}
+};
+
+void placeCampusNodes(Graph& graph) {
+    for (auto& p : campusPositions)
+        graph.setPosition(p[0], p[1], p[2]);
+}
+
+bool parseIntArg(const string& arg, int& value, int low, int high) {
+    long long wide;
+    if (!parseLongArg(arg, wide, low, high))
+        return false;
+    value = wide;
+    return true;
+}
+
+bool parseLongArg(const string& arg, long long& value, long long low, long long high) {
+    try {
+        size_t used;
+        value = std::stoll(arg, &used);
+        return used == arg.size() && value >= low && value <= high;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool parseDoubleArg(const string& arg, double& value, double low, double high) {
+    char* end;
+    errno = 0;
+    value = std::strtod(arg.c_str(), &end);
+    return !arg.empty() && end == arg.c_str() + arg.size() && errno == 0 && value >= low && value <= high;
+}
+
+// Parse a node argument: either a public node number or "x,y" pixel coordinates on
+// map.jpg that are snapped to the graph. node receives the internal id.
+// Returns false for malformed or out of range input.
+bool parseNodeArg(const string& arg, Graph& graph, SpatialIndex& index, int& node) {
+    size_t comma = arg.find(',');
+    if (comma != string::npos) {
+        int px, py;
+        if (!parseIntArg(arg.substr(0, comma), px) || !parseIntArg(arg.substr(comma + 1), py))
+            return false;
+        node = index.snapPoint(px, py);
+        return node >= 0;
+    }
+    if (!parseIntArg(arg, node) || node < 0 || node >= graph.numNodes)
+        return false;
+    node = graph.intId[node];
+    return true;
+}
+
+// Pick the travel profile for type and weather
+int campusProfile(int typeNode, int weather_type) {
+    if (typeNode != 1)
+        return PROFILE_CAR;
+    return weather_type == 1 ? PROFILE_WALK_RAIN : PROFILE_WALK_DRY;
+}
+
+// Departure time from "H" or "H:MM" (24-hour clock) in seconds after midnight
+bool parseClockTime(const string& text, int& seconds) {
+    int hour, minute = 0;
+    char colon, extra;
+    istringstream in(text);
+    if (!(in >> hour))
+        return false;
+    if (in >> colon && (colon != ':' || !(in >> minute) || in >> extra))
+        return false;
+    if (hour < 0 || hour > 23 || minute < 0 || minute > 59)
+        return false;
+    seconds = (hour * 60 + minute) * 60;
+    return true;
+}
+
+// Campus edges per travel profile. They are packed into CSR form at compile time
+// (campus*Csr below), so loading a profile does no graph construction at run time.
+class CampusEdge {
+public:
+    int u, v, weight;   // Undirected, same cost both ways
+};
+
+// Car (PROFILE_CAR)
+constexpr CampusEdge campusCarEdges[] = {
+    {0, 1, 19},     // Main Gate
+    {1, 2, 13},     // towards enrollment office
+    {2, 3, 35},     // towards enrollment office
+    {3, 4, 27},     // Front of enrollment office
+    {4, 6, 28},     // Front of amphitheater
+    {6, 7, 35},     // Front of sitting area
+    {7, 10, 12},    // Front of GYM & MAC
+    {10, 13, 10},   // Parking start front of MAC
+    {13, 14, 11},   // Front of box
+    {14, 15, 17},   // End of box
+    {15, 16, 16},   // Staircase front of MAC
+    {16, 17, 14},   // Front of Library
+    {17, 18, 17},   // End of Library
+    {18, 19, 32},   // Between blocks
+    {19, 20, 7},    // Last stairs
+    {20, 21, 23},   // Start of Gandhi Chowk
+    {21, 22, 10},   // Front of Gandhi Chowk
+    {22, 24, 5},    // Front of 9th block amphitheater
+    {24, 25, 20},   // Back side of 3rd block & front of amphitheater
+    {25, 28, 13},   // Backside of 9th block
+    {28, 29, 3},    // Backside of Frisco
+    {29, 30, 12},   // Backside of Frisco towards food court
+    {30, 31, 5},    // Backside of 5th block
+    {31, 33, 27},   // Backside of Food Court
+    {33, 34, 20},   // Front side of food court 1st gate
+    {34, 37, 7},    // Front of food court
+    {37, 38, 6},    // Towards Hubble
+    {43, 44, 24},   // Towards main gate back of Hubble
+    {44, 45, 10},   // Towards main gate back of Hubble
+    {45, 1, 57},    // Front of gate
+    {1, 46, 15},    // Towards front of Hubble
+    {46, 47, 25},   // Front of Hubble
+    {47, 49, 10},   // Hubble towards 1st block
+    {49, 3, 20},    // Hubble towards enrollment office
+    {53, 38, 20},   // Front side of 2nd gate of food court
+    {53, 43, 23},   // Backside of Hubble
+    {55, 49, 13},   // Towards Hubble
+    {54, 56, 9},    // Inside 1st block & front of wash room
+    {62, 55, 54},   // Front side of 1st block & towards Hubble
+    {63, 64, 30},   // Towards MAC
+    {64, 7, 17},    // Towards sitting area behind MAC
+    {64, 10, 9},    // Towards MAC/GYM
+    {63, 65, 17},   // Towards lib stairs
+    {65, 66, 61},   // Towards Gandhi Chowk
+    {66, 67, 10},   // Towards Gandhi Chowk
+    {66, 24, 28},   // Towards Gandhi Chowk
+    {61, 79, 46},   // Outside 1st block path
+    {79, 77, 10},   // Outside 1st block to 2nd block 2nd path
+    {95, 96, 17},   // Path 6th block main entrance
+    {96, 97, 31},   // Path from 6th block to main road
+    {95, 99, 31},   // 6th to library road
+    {99, 100, 15},  // Main road from library to IT
+    {100, 101, 26}, // Main road to food court 2
+    {105, 106, 43}, // Towards power house
+    {115, 97, 66},  // Main road to front of game office
+    {116, 117, 8},  // Main road for placement activity
+    {131, 117, 28}, // Entrance of ground to intersection of MDP Guest house
+    {131, 132, 5},  // Towards Guest house front of Ground
+    {132, 133, 34}, // Front gate of guest house
+    {131, 135, 10}, // Towards guest house and girls hostel
+    {135, 136, 28}, // 2nd gate of guest house
+    {135, 136, 47}, // Girls hostel main gate
+    {136, 137, 12}, // Girls hostel entrance gate
+    {115, 139, 10}, // 2nd gate of fire station
+    {97, 140, 29},  // Towards Gandhi Chowk
+    {140, 141, 22}, // Towards Gandhi Chowk
+    {141, 143, 10}, // Gandhi Chowk
+    {143, 22, 11},  // Towards other block
+    {141, 144, 17}, // Towards 9th block
+    {141, 145, 10}, // Towards body hostel
+    {145, 146, 38}, // Towards play school
+    {146, 148, 14}, // Front of canteen
+    {148, 150, 33}, // Front of Tulip towards boys hotel
+    {150, 152, 23}, // Front of laboratory
+    {152, 154, 10}, // Towards car gate of boys hostel
+    {152, 159, 10}, // Sitting area towards Tulip
+    {159, 160, 18}, // Front of Tulip
+    {160, 161, 2},  // Towards Tulip 1st gate
+    {163, 164, 3},  // Towards 11th block 1st gate
+    {164, 165, 21}, // 11th and 10th block
+    {165, 166, 23}, // Towards Gandhi Chowk 9th and 10th block
+    {166, 167, 36}, // Towards Gandhi Chowk 9th block
+    {167, 168, 33}, // Towards Gandhi Chowk 9th last gate
+    {168, 184, 4},  // Towards play school
+    {184, 185, 8},  // Towards amphitheater
+    {185, 24, 13},  // Towards 3rd block
+    {175, 195, 23}, // Backroad of 11th and 10th block
+};
+
+// Walking in the rainy season (PROFILE_WALK_RAIN)
+constexpr CampusEdge campusRainEdges[] = {
+    {0, 1, 19},     // Main Gate
+    {1, 2, 13},     // towards enrollment office
+    {3, 4, 27},     // Front of enrollment office
+    {4, 5, 21},     // Door of Enrollment office
+    {7, 8, 7},      // Route for sitting area
+    {8, 9, 1},      // Sitting area
+    {7, 10, 12},    // Front of GYM & MAC
+    {10, 11, 11},   // GYM Gate
+    {10, 12, 11},   // MAC Gate
+    {10, 13, 10},   // Parking start front of MAC
+    {13, 14, 11},   // Front of box
+    {14, 15, 17},   // End of box
+    {15, 16, 16},   // Staircase front of MAC
+    {16, 17, 14},   // Front of Library
+    {17, 18, 17},   // End of Library
+    {18, 19, 32},   // Between blocks
+    {19, 20, 7},    // Last stairs
+    {20, 21, 23},   // Start of Gandhi Chowk
+    {21, 22, 10},   // Front of Gandhi Chowk
+    {22, 23, 6},    // Gandhi Chowk
+    {22, 24, 5},    // Front of 9th block amphitheater
+    {24, 25, 20},   // Back side of 3rd block & front of amphitheater
+    {25, 26, 3},    // Back of 3rd block
+    {25, 28, 13},   // Backside of 9th block
+    {28, 29, 3},    // Backside of Frisco
+    {29, 30, 12},   // Backside of Frisco towards food court
+    {30, 31, 5},    // Backside of 5th block
+    {31, 32, 3},    // Backside entrance of 5th block
+    {34, 35, 10},   // Main gate of food court
+    {34, 36, 9},    // Stair towards food court
+    {34, 37, 7},    // Front of food court
+    {37, 38, 6},    // Towards Hubble
+    {38, 39, 8},    // Food court 2nd gate towards Hubble
+    {39, 40, 4},    // 2nd gate of food court
+    {39, 41, 14},   // Narrow route towards main gate through food court
+    {41, 42, 17},   // Front route towards main gate
+    {42, 68, 14},   // Food court1 back gate
+    {68, 69, 2},    // Inside food court through back gate
+    {69, 70, 2},    // Inside food court towards 2nd gate
+    {70, 40, 10},   // Inside food court towards 2nd gate outwards
+    {69, 71, 10},   // Inside food court towards 1st gate
+    {71, 35, 9},    // Inside food court towards 1st gate outwards
+    {1, 46, 15},    // Towards front of Hubble
+    {46, 47, 25},   // Front of Hubble
+    {47, 48, 4},    // Hubble main gate
+    {47, 49, 10},   // Hubble towards 1st block
+    {49, 3, 20},    // Hubble towards enrollment office
+    {49, 50, 9},    // Side of Hubble towards 1st block
+    {50, 51, 6},    // Towards 1st block
+    {51, 52, 52},   // Towards food court
+    {52, 53, 4},    // Towards food court backside of Hubble
+    {53, 38, 20},   // Front side of 2nd gate of food court
+    {51, 54, 9},    // 1st door of 1st block
+    {54, 55, 12},   // Towards amphitheater
+    {55, 49, 13},   // Towards Hubble
+    {54, 56, 9},    // Inside 1st block & front of wash room
+    {56, 57, 32},   // Inside 1st block & towards 4th block
+    {57, 58, 32},   // Inside 1st block towards 2nd block
+    {58, 59, 20},   // Inside 1st block towards 2nd block
+    {59, 56, 32},   // Inside 1st block towards Library stairs
+    {59, 60, 7},    // Exit of 1st block through library stairs
+    {60, 61, 7},    // Towards library stairs
+    {61, 62, 14},   // Front side of 1st block
+    {62, 55, 54},   // Front side of 1st block & towards Hubble
+    {62, 63, 15},   // Climbing through lib stairs
+    {63, 64, 30},   // Towards MAC
+    {64, 7, 17},    // Towards sitting area behind MAC
+    {64, 10, 9},    // Towards MAC/GYM
+    {63, 65, 17},   // Towards lib stairs
+    {65, 16, 9},    // Towards Library
+    {66, 67, 10},   // Towards Gandhi Chowk
+    {66, 20, 13},   // Towards design block
+    {66, 24, 28},   // Towards Gandhi Chowk
+    {66, 72, 18},   // From stairs to 3rd block
+    {72, 73, 2},    // Gate of 3rd block
+    {72, 74, 3},    // Back gate of 2nd block
+    {74, 75, 22},   // Towards 2nd block
+    {75, 76, 6},    // 2nd block stairs
+    {76, 77, 2},    // 2nd block gate
+    {77, 78, 4},    // 2nd block to 1st block
+    {78, 58, 16},   // Inside 1st block towards Hubble
+    {61, 79, 46},   // Outside 1st block path
+    {79, 77, 10},   // Outside 1st block to 2nd block 2nd path
+    {57, 80, 10},   // 1st block to 4th block
+    {80, 81, 8},    // 1st block path to 4th block path
+    {81, 82, 3},    // 4th block gate
+    {82, 83, 3},    // 4th block stairs
+    {83, 84, 9},    // 4th block stair continues
+    {84, 85, 22},   // 4th block last gate
+    {85, 86, 4},    // 4th to 5th block
+    {86, 87, 2},    // 5th block gate
+    {52, 81, 22},   // Hubble to 4th block gate & 1st block gate
+    {86, 87, 23},   // 5th block stairs
+    {87, 88, 5},    // 5th block stairs
+    {88, 32, 8},    // 5th block gate
+    {17, 89, 51},   // Main road to library (staircase)
+    {18, 93, 39},   // Main road to side of IT
+    {90, 93, 12},   // Main road to IT (staircase)
+    {89, 90, 18},   // Library to IT
+    {89, 91, 3},    // Main gate of Library
+    {90, 92, 3},    // Main gate of IT
+    {93, 94, 26},   // Path towards 6th block
+    {94, 95, 24},   // Path towards backside of 6th block
+    {95, 96, 17},   // Path 6th block main entrance
+    {96, 97, 31},   // Path from 6th block to main road
+    {96, 98, 5},    // 6th block main entrance
+    {95, 99, 31},   // 6th to library road
+    {99, 90, 18},   // IT to main road
+    {99, 100, 15},  // Main road from library to IT
+    {100, 89, 15},  // Main road to Library
+    {100, 101, 26}, // Main road to food court 2
+    {101, 102, 31}, // Main road towards to backside of foodcourt
+    {102, 103, 15}, // Food court backside road
+    {103, 104, 16}, // Backside of food court to backside of MAC
+    {104, 105, 11}, // Backside of MAC
+    {105, 106, 43}, // Towards power house
+    {106, 107, 5},  // Power house gate
+    {107, 108, 9},  // Power house to basketball court
+    {108, 109, 47}, // Basketball court
+    {109, 110, 54}, // Basketball court exit
+    {110, 111, 10}, // Towards Placement office
+    {111, 112, 3},  // Main road of placement office
+    {103, 113, 14}, // Box from food court back
+    {113, 114, 11}, // Box mid to box mid
+    {114, 14, 11},  // Box to main road
+    {115, 97, 66},  // Main road to front of game office
+    {115, 116, 7},  // Main road to game office
+    {116, 117, 8},  // Main road for placement activity
+    {117, 118, 47}, // Main road towards placement activity
+    {118, 119, 3},  // Towards ground
+    {118, 112, 50}, // Basketball court
+    {120, 112, 7},  // Basketball entrance to ground entrance
+    {112, 121, 36}, // Basketball entrance to placement activity block
+    {121, 122, 33}, // Inside placement block
+    {122, 123, 25}, // Exit from placement block
+    {123, 124, 71}, // Corner of ground
+    {124, 125, 104},// Other side of ground
+    {125, 126, 32}, // Front side of ground
+    {126, 127, 18}, // Towards ground
+    {127, 128, 25}, // Front side of ground
+    {128, 129, 36}, // Towards basketball ground
+    {129, 130, 10}, // Basketball back
+    {130, 119, 13}, // Basketball back
+    {131, 128, 40}, // Intersection in front of MDP Guest house
+    {131, 117, 28}, // Entrance of ground to intersection of MDP Guest house
+    {131, 132, 5},  // Towards Guest house front of Ground
+    {132, 133, 34}, // Front gate of guest house
+    {117, 134, 8},  // Museum way
+    {131, 135, 10}, // Towards guest house and girls hostel
+    {135, 136, 28}, // 2nd gate of guest house
+    {136, 133, 15}, // Gate to gate guest house
+    {135, 136, 47}, // Girls hostel main gate
+    {136, 137, 12}, // Girls hostel entrance gate
+    {136, 138, 27}, // Temple
+    {115, 139, 10}, // 2nd gate of fire station
+    {97, 140, 29},  // Towards Gandhi Chowk
+    {140, 141, 22}, // Towards Gandhi Chowk
+    {141, 142, 6},  // Towards amphitheater
+    {141, 143, 10}, // Gandhi Chowk
+    {143, 22, 11},  // Towards other block
+    {141, 144, 17}, // Towards 9th block
+    {141, 145, 10}, // Towards body hostel
+    {145, 146, 38}, // Towards play school
+    {146, 147, 5},  // Entrance of play school
+    {146, 148, 14}, // Front of canteen
+    {148, 149, 12}, // Gate of canteen
+    {148, 150, 33}, // Front of Tulip towards boys hotel
+    {150, 151, 4},  // Tulip 2nd gate towards boys hostel
+    {150, 152, 23}, // Front of laboratory
+    {152, 153, 4},  // Gate of Laboratory
+    {152, 154, 10}, // Towards car gate of boys hostel
+    {154, 155, 5},  // Car gate of boys hostel
+    {154, 156, 6},  // Towards boys hostel entrance
+    {156, 157, 6},  // Boys hostel gate
+    {152, 159, 10}, // Sitting area towards Tulip
+    {159, 160, 18}, // Front of Tulip
+    {160, 161, 2},  // Towards Tulip 1st gate
+    {161, 162, 4},  // 1st gate of Tulip
+    {159, 163, 17}, // Towards 11th block
+    {163, 164, 3},  // Towards 11th block 1st gate
+    {168, 184, 4},  // Towards play school
+    {184, 185, 8},  // Towards amphitheater
+    {185, 186, 13}, // Towards 9th block
+    {185, 24, 13},  // Towards 3rd block
+    {186, 27, 4},   // Towards 9th block main entrance
+    {186, 25, 12},  // Towards 3rd block
+    {188, 179, 4},  // Back gate stair of 9th block
+    {179, 189, 8},  // Stair main gate of 10th block
+    {189, 190, 3},  // Main gate of 10th block
+    {188, 191, 8},  // Back gate of 9th block
+    {191, 192, 34}, // Towards mid of 9th block
+    {192, 187, 11}, // Mid gate of 9th block
+    {192, 182, 31}, // Front gate of 9th block
+    {190, 193, 27}, // Mid of 10th block
+    {193, 176, 24}, // End gate of 10th block
+    {193, 194, 11}, // Mid gate of 10th block
+    {194, 195, 3},  // Between 11th and 10th block
+    {195, 196, 5},  // Downside gate of 11th block
+    {196, 197, 4},  // Towards 11th block stairs
+    {197, 198, 6},  // Towards 11th block stairs
+    {198, 199, 4},  // Towards 11th block stairs
+    {199, 200, 20}, // Towards 11th block main gate
+    {200, 201, 4},  // Towards 11th block gate
+    {201, 202, 1},  // Towards main gate of 11th block
+    {202, 203, 3},  // Main gate of 11th block
+    {202, 204, 12}, // Towards intersection part
+    {203, 205, 2},  // Towards main road
+    {205, 164, 16}, // 11th block main road
+    {175, 195, 23}, // Backroad of 11th and 10th block
+    {206, 207, 3},  // Towards mid of 10th and 11th block
+    {207, 195, 23}, // Mid of 10th and 11th block
+    {170, 204, 18}, // Intersection point
+    {170, 208, 17}, // Towards 3rd gate of 11th block
+    {170, 209, 19}, // Mid gate of 11th block
+    {208, 210, 8},  // Last gate to entrance
+    {210, 211, 3},  // Last gate inside 11th block
+    {211, 212, 8},  // Inside 11th block
+    {212, 213, 25}, // Inside 11th block
+    {213, 214, 23}, // Mid gate of 11th block
+    {214, 209, 4},  // Mid gate entrance
+    {214, 215, 25}, // Towards main gate of 11th block
+    {215, 199, 5},  // Towards stair of 11th block
+    {30, 216, 6},   // Towards Frisco
+    {216, 217, 4},  // Towards 3rd block
+    {216, 218, 7},  // Towards Frisco
+    {219, 31, 10},  // Towards 5th block
+    {219, 220, 5},  // 5th block gate
+    {219, 221, 7},  // Towards Frisco
+    {221, 222, 6},  // Towards Frisco entrance
+    {218, 222, 5},  // Towards Frisco entrance
+    {222, 223, 3},  // Frisco entrance
+    {218, 224, 16},
+    {221, 225, 16},
+    {218, 225, 18},
+    {224, 221, 18},
+    {224, 225, 12},
+    {225, 85, 16},
+    {224, 72, 15},
+    {225, 226, 29},
+    {226, 81, 5},
+    {226, 227, 8},
+    {227, 228, 6},
+    {228, 229, 4},
+    {228, 224, 27},
+    {229, 76, 4},
+    {228, 77, 4},
+    {227, 230, 3},
+    {231, 50, 12},
+    {231, 48, 9},
+};
+
+// Walking in the dry season (PROFILE_WALK_DRY). Edges 1-2 and 1-46 only open at
+// 11:00, see tagCampusTravelTimes.
+constexpr CampusEdge campusDryEdges[] = {
+    {0, 1, 19},     // Main Gate
+    {1, 2, 13},     // towards enrollment office
+    {2, 3, 35},     // towards enrollment office
+    {3, 4, 27},     // Front of enrollment office
+    {4, 5, 21},     // Door of Enrollment office
+    {4, 6, 28},     // Front of amphitheater
+    {6, 7, 35},     // Front of sitting area
+    {7, 8, 7},      // Route for sitting area
+    {8, 9, 1},      // Sitting area
+    {7, 10, 12},    // Front of GYM & MAC
+    {10, 11, 11},   // GYM Gate
+    {10, 12, 11},   // MAC Gate
+    {10, 13, 10},   // Parking start front of MAC
+    {13, 14, 11},   // Front of box
+    {14, 15, 17},   // End of box
+    {15, 16, 16},   // Staircase front of MAC
+    {16, 17, 14},   // Front of Library
+    {17, 18, 17},   // End of Library
+    {18, 19, 32},   // Between blocks
+    {19, 20, 7},    // Last stairs
+    {20, 21, 23},   // Start of Gandhi Chowk
+    {21, 22, 10},   // Front of Gandhi Chowk
+    {22, 23, 6},    // Gandhi Chowk
+    {22, 24, 5},    // Front of 9th block amphitheater
+    {24, 25, 20},   // Back side of 3rd block & front of amphitheater
+    {25, 26, 3},    // Back of 3rd block
+    {25, 28, 13},   // Backside of 9th block
+    {28, 29, 3},    // Backside of Frisco
+    {29, 30, 12},   // Backside of Frisco towards food court
+    {30, 31, 5},    // Backside of 5th block
+    {31, 32, 3},    // Backside entrance of 5th block
+    {31, 33, 27},   // Backside of Food Court
+    {33, 34, 20},   // Front side of food court 1st gate
+    {34, 35, 10},   // Main gate of food court
+    {34, 36, 9},    // Stair towards food court
+    {34, 37, 7},    // Front of food court
+    {37, 38, 6},    // Towards Hubble
+    {38, 39, 8},    // Food court 2nd gate towards Hubble
+    {39, 40, 4},    // 2nd gate of food court
+    {39, 41, 14},   // Narrow route towards main gate through food court
+    {41, 42, 17},   // Front route towards main gate
+    {42, 43, 15},   // Connecting route towards main gate / back side of Hubble
+    {42, 68, 14},   // Food court1 back gate
+    {68, 69, 2},    // Inside food court through back gate
+    {69, 70, 2},    // Inside food court towards 2nd gate
+    {70, 40, 10},   // Inside food court towards 2nd gate outwards
+    {69, 71, 10},   // Inside food court towards 1st gate
+    {71, 35, 9},    // Inside food court towards 1st gate outwards
+    {43, 44, 24},   // Towards main gate back of Hubble
+    {44, 45, 10},   // Towards main gate back of Hubble
+    {45, 1, 57},    // Front of gate
+    {1, 46, 15},    // Towards front of Hubble
+    {46, 47, 25},   // Front of Hubble
+    {47, 48, 4},    // Hubble main gate
+    {47, 49, 10},   // Hubble towards 1st block
+    {49, 3, 20},    // Hubble towards enrollment office
+    {49, 50, 9},    // Side of Hubble towards 1st block
+    {50, 51, 6},    // Towards 1st block
+    {51, 52, 52},   // Towards food court
+    {52, 53, 4},    // Towards food court backside of Hubble
+    {53, 38, 20},   // Front side of 2nd gate of food court
+    {53, 43, 23},   // Backside of Hubble
+    {51, 54, 9},    // 1st door of 1st block
+    {54, 55, 12},   // Towards amphitheater
+    {55, 49, 13},   // Towards Hubble
+    {54, 56, 9},    // Inside 1st block & front of wash room
+    {56, 57, 32},   // Inside 1st block & towards 4th block
+    {57, 58, 32},   // Inside 1st block towards 2nd block
+    {58, 59, 20},   // Inside 1st block towards 2nd block
+    {59, 56, 32},   // Inside 1st block towards Library stairs
+    {59, 60, 7},    // Exit of 1st block through library stairs
+    {60, 61, 7},    // Towards library stairs
+    {61, 62, 14},   // Front side of 1st block
+    {62, 55, 54},   // Front side of 1st block & towards Hubble
+    {62, 63, 15},   // Climbing through lib stairs
+    {63, 64, 30},   // Towards MAC
+    {64, 7, 17},    // Towards sitting area behind MAC
+    {64, 10, 9},    // Towards MAC/GYM
+    {63, 65, 17},   // Towards lib stairs
+    {65, 16, 9},    // Towards Library
+    {65, 66, 61},   // Towards Gandhi Chowk
+    {66, 67, 10},   // Towards Gandhi Chowk
+    {66, 20, 13},   // Towards design block
+    {66, 24, 28},   // Towards Gandhi Chowk
+    {66, 72, 18},   // From stairs to 3rd block
+    {72, 73, 2},    // Gate of 3rd block
+    {72, 74, 3},    // Back gate of 2nd block
+    {74, 75, 22},   // Towards 2nd block
+    {75, 76, 6},    // 2nd block stairs
+    {76, 77, 2},    // 2nd block gate
+    {77, 78, 4},    // 2nd block to 1st block
+    {78, 58, 16},   // Inside 1st block towards Hubble
+    {61, 79, 46},   // Outside 1st block path
+    {79, 77, 10},   // Outside 1st block to 2nd block 2nd path
+    {57, 80, 10},   // 1st block to 4th block
+    {80, 81, 8},    // 1st block path to 4th block path
+    {81, 82, 3},    // 4th block gate
+    {82, 83, 3},    // 4th block stairs
+    {83, 84, 9},    // 4th block stair continues
+    {84, 85, 22},   // 4th block last gate
+    {85, 86, 4},    // 4th to 5th block
+    {86, 87, 2},    // 5th block gate
+    {52, 81, 22},   // Hubble to 4th block gate & 1st block gate
+    {86, 87, 23},   // 5th block stairs
+    {87, 88, 5},    // 5th block stairs
+    {88, 32, 8},    // 5th block gate
+    {17, 89, 51},   // Main road to library (staircase)
+    {18, 93, 39},   // Main road to side of IT
+    {90, 93, 12},   // Main road to IT (staircase)
+    {89, 90, 18},   // Library to IT
+    {89, 91, 3},    // Main gate of Library
+    {90, 92, 3},    // Main gate of IT
+    {93, 94, 26},   // Path towards 6th block
+    {94, 95, 24},   // Path towards backside of 6th block
+    {95, 96, 17},   // Path 6th block main entrance
+    {96, 97, 31},   // Path from 6th block to main road
+    {96, 98, 5},    // 6th block main entrance
+    {95, 99, 31},   // 6th to library road
+    {99, 90, 18},   // IT to main road
+    {99, 100, 15},  // Main road from library to IT
+    {100, 89, 15},  // Main road to Library
+    {100, 101, 26}, // Main road to food court 2
+    {101, 102, 31}, // Main road towards to backside of foodcourt
+    {102, 103, 15}, // Food court backside road
+    {103, 104, 16}, // Backside of food court to backside of MAC
+    {104, 105, 11}, // Backside of MAC
+    {105, 106, 43}, // Towards power house
+    {106, 107, 5},  // Power house gate
+    {107, 108, 9},  // Power house to basketball court
+    {108, 109, 47}, // Basketball court
+    {109, 110, 54}, // Basketball court exit
+    {110, 111, 10}, // Towards Placement office
+    {111, 112, 3},  // Main road of placement office
+    {103, 113, 14}, // Box from food court back
+    {113, 114, 11}, // Box mid to box mid
+    {114, 14, 11},  // Box to main road
+    {115, 97, 66},  // Main road to front of game office
+    {115, 116, 7},  // Main road to game office
+    {116, 117, 8},  // Main road for placement activity
+    {117, 118, 47}, // Main road towards placement activity
+    {118, 119, 3},  // Towards ground
+    {118, 112, 50}, // Basketball court
+    {120, 112, 7},  // Basketball entrance to ground entrance
+    {112, 121, 36}, // Basketball entrance to placement activity block
+    {121, 122, 33}, // Inside placement block
+    {122, 123, 25}, // Exit from placement block
+    {123, 124, 71}, // Corner of ground
+    {124, 125, 104},// Other side of ground
+    {125, 126, 32}, // Front side of ground
+    {126, 127, 18}, // Towards ground
+    {127, 128, 25}, // Front side of ground
+    {128, 129, 36}, // Towards basketball ground
+    {129, 130, 10}, // Basketball back
+    {130, 119, 13}, // Basketball back
+    {131, 128, 40}, // Intersection in front of MDP Guest house
+    {131, 117, 28}, // Entrance of ground to intersection of MDP Guest house
+    {131, 132, 5},  // Towards Guest house front of Ground
+    {132, 133, 34}, // Front gate of guest house
+    {117, 134, 8},  // Museum way
+    {131, 135, 10}, // Towards guest house and girls hostel
+    {135, 136, 28}, // 2nd gate of guest house
+    {136, 133, 15}, // Gate to gate guest house
+    {135, 136, 47}, // Girls hostel main gate
+    {136, 137, 12}, // Girls hostel entrance gate
+    {136, 138, 27}, // Temple
+    {115, 139, 10}, // 2nd gate of fire station
+    {97, 140, 29},  // Towards Gandhi Chowk
+    {140, 141, 22}, // Towards Gandhi Chowk
+    {141, 142, 6},  // Towards amphitheater
+    {141, 143, 10}, // Gandhi Chowk
+    {143, 22, 11},  // Towards other block
+    {141, 144, 17}, // Towards 9th block
+    {141, 145, 10}, // Towards body hostel
+    {145, 146, 38}, // Towards play school
+    {146, 147, 5},  // Entrance of play school
+    {146, 148, 14}, // Front of canteen
+    {148, 149, 12}, // Gate of canteen
+    {148, 150, 33}, // Front of Tulip towards boys hotel
+    {150, 151, 4},  // Tulip 2nd gate towards boys hostel
+    {150, 152, 23}, // Front of laboratory
+    {152, 153, 4},  // Gate of Laboratory
+    {152, 154, 10}, // Towards car gate of boys hostel
+    {154, 155, 5},  // Car gate of boys hostel
+    {154, 156, 6},  // Towards boys hostel entrance
+    {156, 157, 6},  // Boys hostel gate
+    {152, 159, 10}, // Sitting area towards Tulip
+    {159, 160, 18}, // Front of Tulip
+    {160, 161, 2},  // Towards Tulip 1st gate
+    {161, 162, 4},  // 1st gate of Tulip
+    {159, 163, 17}, // Towards 11th block
+    {163, 164, 3},  // Towards 11th block 1st gate
+    {164, 165, 21}, // 11th and 10th block
+    {165, 166, 23}, // Towards Gandhi Chowk 9th and 10th block
+    {166, 167, 36}, // Towards Gandhi Chowk 9th block
+    {167, 168, 33}, // Towards Gandhi Chowk 9th last gate
+    {168, 184, 4},  // Towards play school
+    {184, 185, 8},  // Towards amphitheater
+    {185, 186, 13}, // Towards 9th block
+    {185, 24, 13},  // Towards 3rd block
+    {186, 27, 4},   // Towards 9th block main entrance
+    {186, 25, 12},  // Towards 3rd block
+    {187, 167, 5},  // Mid gate of 9th block
+    {188, 179, 4},  // Back gate stair of 9th block
+    {179, 189, 8},  // Stair main gate of 10th block
+    {189, 190, 3},  // Main gate of 10th block
+    {188, 191, 8},  // Back gate of 9th block
+    {191, 192, 34}, // Towards mid of 9th block
+    {192, 187, 11}, // Mid gate of 9th block
+    {192, 182, 31}, // Front gate of 9th block
+    {190, 193, 27}, // Mid of 10th block
+    {193, 176, 24}, // End gate of 10th block
+    {193, 194, 11}, // Mid gate of 10th block
+    {194, 195, 3},  // Between 11th and 10th block
+    {195, 196, 5},  // Downside gate of 11th block
+    {196, 197, 4},  // Towards 11th block stairs
+    {197, 198, 6},  // Towards 11th block stairs
+    {198, 199, 4},  // Towards 11th block stairs
+    {199, 200, 20}, // Towards 11th block main gate
+    {200, 201, 4},  // Towards 11th block gate
+    {201, 202, 1},  // Towards main gate of 11th block
+    {202, 203, 3},  // Main gate of 11th block
+    {202, 204, 12}, // Towards intersection part
+    {203, 205, 2},  // Towards main road
+    {205, 164, 16}, // 11th block main road
+    {175, 195, 23}, // Backroad of 11th and 10th block
+    {165, 206, 19}, // Main road towards mid of 11th and 10th block
+    {206, 207, 3},  // Towards mid of 10th and 11th block
+    {207, 195, 23}, // Mid of 10th and 11th block
+    {170, 204, 18}, // Intersection point
+    {170, 208, 17}, // Towards 3rd gate of 11th block
+    {170, 209, 19}, // Mid gate of 11th block
+    {208, 210, 8},  // Last gate to entrance
+    {210, 211, 3},  // Last gate inside 11th block
+    {211, 212, 8},  // Inside 11th block
+    {212, 213, 25}, // Inside 11th block
+    {213, 214, 23}, // Mid gate of 11th block
+    {214, 209, 4},  // Mid gate entrance
+    {214, 215, 25}, // Towards main gate of 11th block
+    {215, 199, 5},  // Towards stair of 11th block
+    {30, 216, 6},   // Towards Frisco
+    {216, 217, 4},  // Towards 3rd block
+    {216, 218, 7},  // Towards Frisco
+    {219, 31, 10},  // Towards 5th block
+    {219, 220, 5},  // 5th block gate
+    {219, 221, 7},  // Towards Frisco
+    {221, 222, 6},  // Towards Frisco entrance
+    {218, 222, 5},  // Towards Frisco entrance
+    {222, 223, 3},  // Frisco entrance
+    {218, 224, 16},
+    {221, 225, 16},
+    {218, 225, 18},
+    {224, 221, 18},
+    {224, 225, 12},
+    {225, 85, 16},
+    {224, 72, 15},
+    {225, 226, 29},
+    {226, 81, 5},
+    {226, 227, 8},
+    {227, 228, 6},
+    {228, 229, 4},
+    {228, 224, 27},
+    {229, 76, 4},
+    {228, 77, 4},
+    {227, 230, 3},
+    {231, 50, 12},
+    {231, 48, 9},
+};
+
+// Compile-time CSR of each profile, in read-only data
+constexpr auto campusCarCsr = packEdges<CAMPUS_NODES>(campusCarEdges);
+constexpr auto campusRainCsr = packEdges<CAMPUS_NODES>(campusRainEdges);
+constexpr auto campusDryCsr = packEdges<CAMPUS_NODES>(campusDryEdges);
+
+// Load the campus edges of a travel profile into a graph of CAMPUS_NODES nodes
+// Returns false when the profile is unknown
+bool buildCampusGraph(Graph& graph, int profile) {
+    switch (profile) {
+    case PROFILE_CAR:
+        graph.loadPacked(campusCarCsr);
+        return true;
+    case PROFILE_WALK_RAIN:
+        graph.loadPacked(campusRainCsr);
+        return true;
+    case PROFILE_WALK_DRY:
+        graph.loadPacked(campusDryCsr);
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Time-of-day costs on the campus. The only schedule on record comes from the
+// original campus data, which had two dry-season walking graphs: one for times up
+// to 10 without the edges 1-2 and 1-46 near the main gate, and one for later hours
+// with them. Here those edges open at 11:00; before that a walker waits for them,
+// which a route only does when nothing else gets there sooner. The car and rain
+// graphs never depended on the time, so they get no profiles.
+void tagCampusTravelTimes(Graph& graph, int profile) {
+    if (profile != PROFILE_WALK_DRY)
+        return;
+    int fromEleven = graph.addTravelProfile({{0, TravelBreakpoint::CLOSED}, {11 * 60, 100}});
+    for (int v : {2, 46}) {
+        graph.setArcProfile(1, v, fromEleven);
+        graph.setArcProfile(v, 1, fromEleven);
+    }
+}
+
+// Stairs taken from the survey notes on the campus edges. Edges only leading to
+// stairs are not tagged. Profiles without one of these edges skip it.
+const int campusStairs[][2] = {
+    {15, 16},    // Staircase front of MAC
+    {19, 20},    // Last stairs
+    {34, 36},    // Stair towards food court
+    {59, 60},    // Exit of 1st block through library stairs
+    {62, 63},    // Climbing through lib stairs
+    {75, 76},    // 2nd block stairs
+    {82, 83},    // 4th block stairs
+    {83, 84},    // 4th block stair continues
+    {86, 87},    // 5th block stairs
+    {87, 88},    // 5th block stairs
+    {17, 89},    // Main road to library (staircase)
+    {90, 93},    // Main road to IT (staircase)
+    {188, 179},  // Back gate stair of 9th block
+    {179, 189},  // Stair main gate of 10th block
+};
+
+void tagCampusAccess(Graph& graph) {
+    for (const auto& stairs : campusStairs) {
+        graph.setArcAccess(stairs[0], stairs[1], ACCESS_STAIRS);
+        graph.setArcAccess(stairs[1], stairs[0], ACCESS_STAIRS);
+    }
+}
+
+// Turn rules for cars. U-turns are only possible at dead ends, as a three-point
+// turn. At the main gate junction (1) cars coming in through the gate cannot swing
+// back onto the road behind Hubble (45). At the gym junction (10) the parking lane
+// (13-15) is entered and left on the side of the sitting area (7) only, not
+// straight from or onto the MAC side road (64); turning in from 7 is slowed down.
+void tagCampusTurns(Graph& graph, int profile) {
+    if (profile != PROFILE_CAR)
+        return;
+    graph.enableTurns(20);
+    graph.addTurnRule(0, 1, 45, TURN_FORBIDDEN);
+    graph.addTurnRule(64, 10, 13, TURN_FORBIDDEN);
+    graph.addTurnRule(13, 10, 64, TURN_FORBIDDEN);
+    graph.addTurnRule(7, 10, 13, 4);
+}
+
+// Build a campus profile with its facilities, time-of-day costs, turn rules and map
+// positions, renumbered with the given node order. Returns false when no profile
+// matches.
+bool loadCampusGraph(Graph& graph, int profile, const string& order) {
+    if (!buildCampusGraph(graph, profile))
+        return false;
+    tagCampusTravelTimes(graph, profile);
+    tagCampusTurns(graph, profile);
+    tagCampusFacilities(graph);
+    tagCampusAccess(graph);
+    placeCampusNodes(graph);
+    return applyNodeOrder(graph, order);
+}
+
+// ---------------------------------------------------------------------------
+// Router: the engine API declared in pathfinder.h. Each profile's graph and
+// indexes are built and finalized once, in load() or on the profile's first
+// query when RouterOptions::lazy is set. After that the searches only read them,
+// so concurrent queries need no locks.
+// ---------------------------------------------------------------------------
+
+// True when the facility tables answer k = 1 queries on the graph exactly: they
+// are node-based and ignore the departure time. Elsewhere they are only bounds.
+bool facilityTablesApply(const Graph& graph) {
+    return !graph.timeDependent() && !graph.turnsModelled();
+}
+
+class Router::Impl {
+public:
+    class Profile {
+    public:
+        once_flag built;
+        unique_ptr<Graph> graph;
+        unique_ptr<SpatialIndex> spatial;
+        vector<unique_ptr<FacilityIndex>> facilities;  // [accessibility features avoided]
+    };
+
+    string order;
+    Profile profiles[NUM_CAMPUS_PROFILES];
+
+    // The profile, built on first use; safe to call from several threads
+    Profile& profile(int p) {
+        call_once(profiles[p].built, [this, p]() { build(profiles[p], p); });
+        return profiles[p];
+    }
+
+private:
+    void build(Profile& profile, int p) {
+        profile.graph.reset(new Graph(CAMPUS_NODES));
+        Graph& graph = *profile.graph;
+        loadCampusGraph(graph, p, order);
+        graph.finalize();
+        profile.spatial.reset(new SpatialIndex(graph));
+        profile.spatial->refresh();
+        for (int avoid = 0; avoid < NUM_ACCESS_MASKS; ++avoid) {
+            profile.facilities.emplace_back(new FacilityIndex(graph, avoid));
+            for (int c = 0; c < NUM_FACILITY_CATEGORIES; ++c)
+                profile.facilities.back()->refresh(Facility(1 << c));
+        }
+    }
+};
+
+Router::Router() : impl(new Impl) {}
+
+Router::~Router() {}
+
+shared_ptr<const Router> Router::load(const RouterOptions& options, string* error) {
+    if (!knownNodeOrder(options.order)) {
+        if (error)
+            *error = "Unknown node order: " + options.order;
+        return nullptr;
+    }
+    shared_ptr<Router> router(new Router());
+    router->impl->order = options.order;
+    if (!options.lazy) {
+        for (int p = 0; p < NUM_CAMPUS_PROFILES; ++p)
+            router->impl->profile(p);
+    }
+    return router;
+}
+
+int Router::nodeCount() const {
+    return CAMPUS_NODES;
+}
+
+int Router::resolveNode(const string& arg, int profile) const {
+    if (profile < 0 || profile >= NUM_CAMPUS_PROFILES)
+        return -1;
+    Impl::Profile& built = impl->profile(profile);
+    Graph& graph = *built.graph;
+    int node;
+    if (!parseNodeArg(arg, graph, *built.spatial, node))
+        return -1;
+    return graph.extId[node];
+}
+
+// Public node numbers from the root of a search tree to node v
+void treePath(Graph& graph, const vector<int>& parent, int v, vector<int>& path) {
+    path.clear();
+    for (; v != -1; v = parent[v])
+        path.push_back(graph.extId[v]);
+    reverse(path.begin(), path.end());
+}
+
+// Public node numbers from src along the arc tree of a turn-aware search to the
+// head of lastArc (just src when lastArc is -1). A node may appear twice.
+void arcTreePath(Graph& graph, const vector<int>& parentArc, int src, int lastArc, vector<int>& path) {
+    path.clear();
+    for (int e = lastArc; e >= 0; e = parentArc[e])
+        path.push_back(graph.extId[graph.head[e]]);
+    path.push_back(graph.extId[src]);
+    reverse(path.begin(), path.end());
+}
+
+// Search one route on a profile graph, internal node ids in and public ones out
+void searchRoute(Graph& graph, int src, int dst, int departure, SearchControl* control, RouteResult& out) {
+    out.found = false;
+    out.distance = 0;
+    out.path.clear();
+    out.exhausted = false;
+    if (control)
+        control->exhausted = false;
+
+    // Turn-aware routes may pass a node twice, so they are read from the arc tree
+    if (graph.turnsModelled()) {
+        vector<int> parentArc;
+        int lastArc;
+        int distance = turnAwareSearch(graph, src, dst, departure, parentArc, lastArc, control);
+        if (distance == INT_MAX) {
+            out.exhausted = control && control->exhausted;
+            return;
+        }
+        arcTreePath(graph, parentArc, src, lastArc, out.path);
+        out.found = true;
+        out.distance = distance;
+        return;
+    }
+    vector<int> parent;
+    int distance = aStarSearch(graph, src, dst, parent, departure, control);
+    if (distance == INT_MAX) {
+        out.exhausted = control && control->exhausted;
+        return;
+    }
+    treePath(graph, parent, dst, out.path);
+    out.found = true;
+    out.distance = distance;
+}
+
+// SearchControl carrying the limits of a query
+SearchControl limitedSearch(const QueryLimits& limits) {
+    SearchControl control;
+    control.avoid = limits.avoid & (NUM_ACCESS_MASKS - 1);
+    control.maxExpansions = limits.maxExpansions;
+    control.cancel = limits.cancel;
+    return control;
+}
+
+bool Router::route(int source, int target, int profile, int departure, RouteResult& out,
+                   const QueryLimits& limits) const {
+    out.found = false;
+    out.distance = 0;
+    out.path.clear();
+    out.optimal = true;
+    out.exhausted = false;
+    if (profile < 0 || profile >= NUM_CAMPUS_PROFILES || source < 0 || source >= CAMPUS_NODES ||
+        target < 0 || target >= CAMPUS_NODES)
+        return false;
+    Graph& graph = *impl->profile(profile).graph;
+    SearchControl control = limitedSearch(limits);
+    searchRoute(graph, graph.intId[source], graph.intId[target], departure, &control, out);
+    return !control.stopped;
+}
+
+// The optimal search is bounded by the cost of the early route, so it never queues
+// a node that cannot lie on a better one
+bool Router::routeProgressive(int source, int target, int profile, int departure, double suboptimality,
+                              const function<void(const RouteResult&)>& onResult,
+                              const QueryLimits& limits, ProgressiveState* state) const {
+    if (profile < 0 || profile >= NUM_CAMPUS_PROFILES || source < 0 || source >= CAMPUS_NODES ||
+        target < 0 || target >= CAMPUS_NODES)
+        return false;
+    Graph& graph = *impl->profile(profile).graph;
+    int src = graph.intId[source], dst = graph.intId[target];
+    SearchControl control = limitedSearch(limits);
+    control.heuristicPercent = max(100, (int)lround(suboptimality * 100));
+    RouteResult result;
+
+    if (state && state->quickReported) {
+        // A rerun: the client has the quick route already
+        result = state->quick;
+        control.heuristicPercent = 100;
+        control.upperBound = result.distance;
+    } else if (control.heuristicPercent > 100) {
+        searchRoute(graph, src, dst, departure, &control, result);
+        if (control.stopped)
+            return false;
+        result.optimal = !result.found;
+        onResult(result);
+        if (!result.found)
+            return true;
+        if (state) {
+            state->quickReported = true;
+            state->quick = result;
+        }
+        control.heuristicPercent = 100;
+        control.upperBound = result.distance;
+    }
+    RouteResult early = result;
+    searchRoute(graph, src, dst, departure, &control, result);
+    if (control.stopped)
+        return false;
+    if (result.exhausted && early.found) {
+        early.exhausted = true;
+        onResult(early);
+        return true;
+    }
+    result.optimal = true;
+    onResult(result);
+    return true;
+}
+
+// A lone target is answered with A*, several with one sweep from the shared source.
+// The one-to-many sweep is node-based, so graphs that model turns run the
+// turn-aware A* per target.
+bool Router::routeMany(int source, const vector<int>& targets, int profile, int departure,
+                       vector<RouteResult>& out, const QueryLimits& limits) const {
+    out.resize(targets.size());
+    if (profile < 0 || profile >= NUM_CAMPUS_PROFILES || source < 0 || source >= CAMPUS_NODES)
+        return false;
+    for (int target : targets) {
+        if (target < 0 || target >= CAMPUS_NODES)
+            return false;
+    }
+    Graph& graph = *impl->profile(profile).graph;
+    if (targets.size() == 1 || graph.turnsModelled()) {
+        for (size_t i = 0; i < targets.size(); ++i) {
+            if (!route(source, targets[i], profile, departure, out[i], limits))
+                return false;
+        }
+        return true;
+    }
+    vector<int> internal;
+    for (int target : targets)
+        internal.push_back(graph.intId[target]);
+    vector<int> dist, parent;
+    SearchControl control = limitedSearch(limits);
+    oneToManySearch(graph, graph.intId[source], internal, dist, parent, departure, &control);
+    if (control.stopped)
+        return false;
+    for (size_t i = 0; i < targets.size(); ++i) {
+        RouteResult& result = out[i];
+        result.optimal = true;
+        result.found = dist[internal[i]] != INT_MAX;
+        result.exhausted = !result.found && control.exhausted;
+        result.distance = result.found ? dist[internal[i]] : 0;
+        if (result.found)
+            treePath(graph, parent, internal[i], result.path);
+        else
+            result.path.clear();
+    }
+    return true;
+}
+
+// k = 1 is read from the prebuilt FacilityIndex table when travel times do not
+// depend on the departure and turns are not modelled; otherwise one
+// early-terminating search answers it, over arcs when turns are modelled, with the
+// table's distances as its A* lower bounds
+bool Router::nearest(int source, Facility category, int k, int profile, int departure,
+                     vector<FacilityResult>& out, const QueryLimits& limits, bool* exhausted) const {
+    out.clear();
+    if (exhausted)
+        *exhausted = false;
+    if (profile < 0 || profile >= NUM_CAMPUS_PROFILES || source < 0 || source >= CAMPUS_NODES)
+        return false;
+    Graph& graph = *impl->profile(profile).graph;
+    int src = graph.intId[source];
+    int avoid = limits.avoid & (NUM_ACCESS_MASKS - 1);
+    FacilityIndex& index = *impl->profile(profile).facilities[avoid];
+    int c = Graph::facilityIndex(category);
+    SearchControl control;
+    control.avoid = avoid;
+    control.maxExpansions = limits.maxExpansions;
+    control.cancel = limits.cancel;
+
+    if (graph.turnsModelled()) {
+        vector<int> parentArc, lastArc;
+        vector<FacilityMatch> matches = turnAwareNearestFacilities(graph, src, category, k, parentArc, lastArc,
+                                                                   departure, avoid, index.distance[c].data(), &control);
+        if (control.stopped)
+            return false;
+        out.resize(matches.size());
+        for (size_t i = 0; i < matches.size(); ++i) {
+            out[i].node = graph.extId[matches[i].node];
+            out[i].distance = matches[i].distance;
+            arcTreePath(graph, parentArc, src, lastArc[i], out[i].path);
+        }
+        if (exhausted)
+            *exhausted = control.exhausted;
+        return true;
+    }
+
+    if (k == 1 && facilityTablesApply(graph)) {
+        int facility = index.nearest[c][src];
+        if (facility == -1)
+            return true;
+        out.resize(1);
+        out[0].node = graph.extId[facility];
+        out[0].distance = index.distance[c][src];
+        for (int v = src; v != -1; v = index.nextHop[c][v])
+            out[0].path.push_back(graph.extId[v]);
+        return true;
+    }
+
+    vector<int> parent;
+    vector<FacilityMatch> matches = nearestFacilities(graph, src, category, k, parent, departure, avoid,
+                                                      index.distance[c].data(), &control);
+    if (control.stopped)
+        return false;
+    out.resize(matches.size());
+    for (size_t i = 0; i < matches.size(); ++i) {
+        out[i].node = graph.extId[matches[i].node];
+        out[i].distance = matches[i].distance;
+        treePath(graph, parent, matches[i].node, out[i].path);
+    }
+    if (exhausted)
+        *exhausted = control.exhausted;
+    return true;
+}
+
+// "a -> b -> c ", the path format of every answer
+void appendPath(string& text, const vector<int>& path) {
+    for (size_t i = 0; i < path.size(); ++i) {
+        if (i > 0)
+            text += "-> ";
+        text += to_string(path[i]);
+        text += ' ';
+    }
+}
+
+void formatRoute(const RouteResult& route, string& text) {
+    text.clear();
+    if (!route.found) {
+        text = route.exhausted ? "No path found within the search budget.\n" : "No path found from source to target.\n";
+        return;
+    }
+    text += route.exhausted ? "Path found within the search budget, possibly not the shortest. Distance from source to target: "
+                            : "Shortest path found. Distance from source to target: ";
+    text += to_string(route.distance);
+    text += "\nPath: ";
+    appendPath(text, route.path);
+    text += '\n';
+}
+
+void formatNearest(const vector<FacilityResult>& matches, const string& name, string& text, bool exhausted) {
+    text.clear();
+    if (matches.empty()) {
+        text = exhausted ? "No " + name + " found within the search budget.\n" : "No " + name + " reachable from source.\n";
+        return;
+    }
+    for (size_t i = 0; i < matches.size(); ++i) {
+        text += "Nearest " + name + " #" + to_string(i + 1) + ": node " + to_string(matches[i].node) +
+                ", distance " + to_string(matches[i].distance) + "\nPath: ";
+        appendPath(text, matches[i].path);
+        text += '\n';
+    }
+    if (exhausted)
+        text += "Search budget reached before more " + name + " were found.\n";
+}
+
+// ---------------------------------------------------------------------------
+// Packed paths: zigzag varint deltas of consecutive public node numbers
+// ---------------------------------------------------------------------------
+
+void appendVarint(string& bytes, uint32_t value) {
+    while (value >= 0x80) {
+        bytes += char(value | 0x80);
+        value >>= 7;
+    }
+    bytes += char(value);
+}
+
+// Reads one varint of at most 5 bytes from [p, end); false if it runs past end
+inline bool readVarint(const unsigned char*& p, const unsigned char* end, uint32_t& value) {
+    if (p != end && *p < 0x80) {
+        value = *p++;
+        return true;
+    }
+    value = 0;
+    for (int shift = 0; shift < 35 && p != end; shift += 7) {
+        uint32_t byte = *p++;
+        value |= (byte & 0x7f) << shift;
+        if (byte < 0x80)
+            return true;
+    }
+    return false;
+}
+
+inline uint32_t zigzag(int delta) {
+    return ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+}
+
+inline int unzigzag(uint32_t value) {
+    return (int)(value >> 1) ^ -(int)(value & 1);
+}
+
+void encodePath(const vector<int>& path, string& bytes) {
+    appendVarint(bytes, path.size());
+    int previous = 0;
+    for (int v : path) {
+        appendVarint(bytes, zigzag((int)((uint32_t)v - (uint32_t)previous)));
+        previous = v;
+    }
+}
+
+bool decodePath(const string& bytes, size_t& pos, vector<int>& path) {
+    const unsigned char* p = (const unsigned char*)bytes.data() + pos;
+    const unsigned char* end = (const unsigned char*)bytes.data() + bytes.size();
+    uint32_t count, delta;
+    // Every node takes at least one byte, which also bounds the allocation
+    if (!readVarint(p, end, count) || count > (size_t)(end - p))
+        return false;
+    path.resize(count);
+    uint32_t v = 0;               // Unsigned, so malformed deltas wrap instead of overflowing
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!readVarint(p, end, delta))
+            return false;
+        v += unzigzag(delta);
+        path[i] = v;
+    }
+    pos = p - (const unsigned char*)bytes.data();
+    return true;
+}
+
+// A route is its flags (found, optimal, exhausted), its distance and its path
+int PackedRoutes::add(const RouteResult& route) {
+    if (bytes.size() > UINT32_MAX || offsets.size() >= (size_t)INT_MAX)
+        return -1;
+    offsets.push_back(bytes.size());
+    bytes += char(route.found | route.optimal << 1 | route.exhausted << 2);
+    appendVarint(bytes, route.distance);
+    encodePath(route.path, bytes);
+    return offsets.size() - 1;
+}
+
+bool PackedRoutes::get(int index, RouteResult& out) const {
+    if (index < 0 || index >= size())
+        return false;
+    size_t pos = offsets[index];
+    int flags = (unsigned char)bytes[pos++];
+    const unsigned char* p = (const unsigned char*)bytes.data() + pos;
+    uint32_t distance;
+    if (!readVarint(p, (const unsigned char*)bytes.data() + bytes.size(), distance) || distance > INT_MAX)
+        return false;
+    pos = p - (const unsigned char*)bytes.data();
+    out.found = flags & 1;
+    out.optimal = flags & 2;
+    out.exhausted = flags & 4;
+    out.distance = distance;
+    return decodePath(bytes, pos, out.path);
+}
+
+void PackedRoutes::shrink() {
+    bytes.shrink_to_fit();
+    offsets.shrink_to_fit();
+}
+
+void PackedRoutes::clear() {
+    bytes.clear();
+    offsets.clear();
+}
+
+size_t PackedRoutes::memoryBytes() const {
+    return bytes.capacity() + offsets.capacity() * sizeof(uint32_t) + sizeof(*this);
+}
+
+// --nearest <source_node> <category> <k> <type> <time> <weather>
+int nearestMain(int argc, char* argv[], const string& order, const QueryLimits& limits) {
+    if (argc != 8) {
+        std::cerr << "Usage: " << argv[0] << " --nearest <source_node> <washroom|exit|medical|food> <k> <type> <time> <weather>" << std::endl;
+        return 1;
+    }
+
+    Facility category;
+    if (!parseFacility(argv[3], category)) {
+        std::cerr << "Unknown facility category: " << argv[3] << std::endl;
+        return 1;
+    }
+    int k, type, weather;
+    if (!parseIntArg(argv[4], k)) {
+        std::cerr << "Invalid number of facilities: " << argv[4] << std::endl;
+        return 1;
+    }
+    if (!parseIntArg(argv[5], type) || !parseIntArg(argv[7], weather)) {
+        std::cerr << "Invalid type or weather: " << argv[5] << " " << argv[7] << std::endl;
+        return 1;
+    }
+    int departure;
+    if (!parseClockTime(argv[6], departure)) {
+        std::cerr << "Invalid time: " << argv[6] << std::endl;
+        return 1;
+    }
+
+    RouterOptions options;
+    options.order = order;
+    options.lazy = true;
+    shared_ptr<const Router> router = Router::load(options);
+    int profile = campusProfile(type, weather);
+    int sourceNode = router->resolveNode(argv[2], profile);
+    if (sourceNode < 0) {
+        std::cerr << "Invalid source node: " << argv[2] << std::endl;
+        return 1;
+    }
+
+    vector<FacilityResult> matches;
+    string text;
+    bool exhausted;
+    router->nearest(sourceNode, category, k, profile, departure, matches, limits, &exhausted);
+    formatNearest(matches, argv[3], text, exhausted);
+    cout << text;
+    return 0;
+}
+
+// --matrix <type> <time> <weather> <node|x,y>...
+// Distance table between the given nodes when leaving at <time>, step-free with
+// --access (see distanceMatrix). Profiles that model turns are rejected, since the
+// node-based search would give distances that route() does not.
+int matrixMain(int argc, char* argv[], const string& order, const QueryLimits& limits) {
+    if (argc < 6) {
+        std::cerr << "Usage: " << argv[0] << " --matrix <type> <time> <weather> <node|x,y> <node|x,y>..." << std::endl;
+        return 1;
+    }
+
+    int type, weather;
+    if (!parseIntArg(argv[2], type) || !parseIntArg(argv[4], weather)) {
+        std::cerr << "Invalid type or weather: " << argv[2] << " " << argv[4] << std::endl;
+        return 1;
+    }
+    int departure;
+    if (!parseClockTime(argv[3], departure)) {
+        std::cerr << "Invalid time: " << argv[3] << std::endl;
+        return 1;
+    }
+    Graph graph(CAMPUS_NODES);
+    if (!loadCampusGraph(graph, campusProfile(type, weather), order)) {
+        return 0;
+    }
+    if (graph.turnsModelled()) {
+        std::cerr << "--matrix does not support profiles with turn rules (type " << type << ")" << std::endl;
+        return 1;
+    }
+
+    SpatialIndex spatialIndex(graph);
+    vector<int> nodes;
+    for (int i = 5; i < argc; ++i) {
+        int node;
+        if (!parseNodeArg(argv[i], graph, spatialIndex, node)) {
+            std::cerr << "Invalid node: " << argv[i] << std::endl;
+            return 1;
+        }
+        nodes.push_back(node);
+    }
+
+    vector<vector<int>> dist = distanceMatrix(graph, nodes, departure, limits.avoid);
+    cout << "from\\to";
+    for (int node : nodes)
+        cout << "\t" << graph.extId[node];
+    cout << endl;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        cout << graph.extId[nodes[i]];
+        for (int node : nodes) {
+            if (dist[i][node] == INT_MAX)
+                cout << "\t-";
+            else
+                cout << "\t" << dist[i][node];
+        }
+        cout << endl;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Query log files; QueryLogRing and QueryLog are in pathfinder_internal.h
+// ---------------------------------------------------------------------------
+
+void encodeQueryRecord(const QueryRecord& r, unsigned char* out) {
+    memset(out, 0, QUERY_RECORD_BYTES);
+    out[0] = QUERY_RECORD_TAG;
+    out[1] = (unsigned char)min(max(r.type, 0), 255);
+    out[2] = (unsigned char)min(max(r.weather, 0), 255);
+    for (int i = 0; i < 2; ++i)
+        out[4 + i] = (unsigned char)(r.minute >> (8 * i));
+    for (int i = 0; i < 8; ++i)
+        out[8 + i] = (unsigned char)((unsigned long long)r.timestamp >> (8 * i));
+    for (int i = 0; i < 4; ++i) {
+        out[16 + i] = (unsigned char)((unsigned)r.source >> (8 * i));
+        out[20 + i] = (unsigned char)((unsigned)r.target >> (8 * i));
+    }
+}
+
+bool decodeQueryRecord(const unsigned char* in, QueryRecord& r) {
+    if (in[0] != QUERY_RECORD_TAG)
+        return false;
+    unsigned long long timestamp = 0;
+    unsigned source = 0, target = 0;
+    for (int i = 0; i < 8; ++i)
+        timestamp |= (unsigned long long)in[8 + i] << (8 * i);
+    for (int i = 0; i < 4; ++i) {
+        source |= (unsigned)in[16 + i] << (8 * i);
+        target |= (unsigned)in[20 + i] << (8 * i);
+    }
+    r.type = in[1];
+    r.weather = in[2];
+    r.minute = in[4] | in[5] << 8;
+    r.timestamp = (long long)timestamp;
+    r.source = (int)source;
+    r.target = (int)target;
+    return true;
+}
+
+// Reads a whole query log. Returns false with an error if the file is missing or
+// not a query log.
+bool readQueryLog(const string& path, vector<QueryRecord>& records, string& error) {
+    ifstream file(path, ios::binary);
+    if (!file) {
+        error = "Cannot open " + path;
+        return false;
+    }
+    unsigned char bytes[QUERY_RECORD_BYTES];
+    while (file.read((char*)bytes, QUERY_RECORD_BYTES)) {
+        QueryRecord r;
+        if (!decodeQueryRecord(bytes, r)) {
+            error = path + ": bad record " + to_string(records.size());
+            return false;
+        }
+        records.push_back(r);
+    }
+    if (file.gcount() != 0) {
+        error = path + ": truncated record at the end";
+        return false;
+    }
+    return true;
+}
+
+// True if the file starts like a query log rather than a text workload
+bool isQueryLog(const string& path) {
+    ifstream file(path, ios::binary);
+    return file && file.peek() == QUERY_RECORD_TAG;
+}
+
+// Latency percentiles and a power-of-two histogram of per-query latencies in us
+void printLatencyDistribution(ostream& out, vector<double> latencies) {
+    if (latencies.empty())
+        return;
+    sort(latencies.begin(), latencies.end());
+    auto at = [&](double q) {
+        return latencies[min(latencies.size() - 1, (size_t)(q * latencies.size()))];
+    };
+    double sum = 0;
+    for (double l : latencies)
+        sum += l;
+    out << "Latency (us): mean " << sum / latencies.size() << ", p50 " << at(0.5) << ", p90 " << at(0.9)
+        << ", p99 " << at(0.99) << ", p99.9 " << at(0.999) << ", max " << latencies.back() << endl;
+
+    vector<long long> buckets;
+    for (double l : latencies) {
+        size_t b = 0;
+        while (b < 40 && (double)(1LL << (b + 1)) <= l)
+            b++;
+        if (buckets.size() <= b)
+            buckets.resize(b + 1, 0);
+        buckets[b]++;
+    }
+    for (size_t b = 0; b < buckets.size(); ++b) {
+        if (buckets[b] == 0)
+            continue;
+        out << "  " << (b == 0 ? 0LL : 1LL << b) << "-" << (1LL << (b + 1)) << " us: " << buckets[b]
+            << " (" << 100.0 * buckets[b] / latencies.size() << "%)" << endl;
+    }
+}
+
+const int MAX_REPLAY_ROUNDS = 1000;
+const double MAX_REPLAY_SPEED = 10000;
+const int MAX_THREADS = 1024;     // Replay threads or server workers
+
+// --replay <queries_file|query_log> [rounds] [speed] [threads]
+// Replays a query workload through Router::route. A text workload has one query per line
+// in command line form, <source_node|x,y> <target_node|x,y> <type> <time>
+// <weather>, and lines starting with '#' are skipped; this is also the training
+// run of the PGO build. A query log from --query-log is detected by its tag.
+// speed 0 (the default) sends queries back to back and reports service times.
+// speed s > 0 sends logged queries at s times their recorded pace, and latency
+// counts from a query's scheduled send time, so queueing behind slow queries
+// shows up as it did in production. Combine with --order or another build to
+// compare engine configurations on the same load.
+int replayMain(int argc, char* argv[], const string& order) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " --replay <queries_file|query_log> [rounds] [speed] [threads]" << std::endl;
+        return 1;
+    }
+    int rounds = 5, threadCount = 1;
+    double speed = 0;
+    if ((argc > 3 && !parseIntArg(argv[3], rounds, 1, MAX_REPLAY_ROUNDS)) ||
+        (argc > 4 && !parseDoubleArg(argv[4], speed, 0, MAX_REPLAY_SPEED)) ||
+        (argc > 5 && !parseIntArg(argv[5], threadCount, 1, MAX_THREADS))) {
+        std::cerr << "Usage: " << argv[0] << " --replay <queries_file|query_log> [rounds] [speed] [threads]" << std::endl;
+        std::cerr << "rounds 1-" << MAX_REPLAY_ROUNDS << ", speed 0-" << MAX_REPLAY_SPEED << ", threads 1-"
+                  << MAX_THREADS << std::endl;
+        return 1;
+    }
+    string path = argv[2];
+
+    RouterOptions options;
+    options.order = order;
+    shared_ptr<const Router> router = Router::load(options);
+
+    // Parse the whole workload first so only routing is timed
+    class Query {
+    public:
+        int profile, source, target, departure;   // Public node numbers
+        long long offset;           // Recorded arrival after the earliest query, us
+    };
+    vector<Query> queries;
+    if (isQueryLog(path)) {
+        vector<QueryRecord> records;
+        string error;
+        if (!readQueryLog(path, records, error)) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+        // Logs from several processes may be slightly out of order, so offsets count
+        // from the earliest timestamp rather than the first record
+        long long earliest = LLONG_MAX;
+        for (const QueryRecord& r : records)
+            earliest = min(earliest, r.timestamp);
+        for (size_t i = 0; i < records.size(); ++i) {
+            const QueryRecord& r = records[i];
+            Query q;
+            q.profile = campusProfile(r.type, r.weather);
+            if (r.source < 0 || r.source >= router->nodeCount() || r.target < 0 || r.target >= router->nodeCount() ||
+                r.minute < 0 || r.minute >= MINUTES_PER_DAY) {
+                std::cerr << path << ": invalid query in record " << i << std::endl;
+                return 1;
+            }
+            q.source = r.source;
+            q.target = r.target;
+            q.departure = r.minute * 60;
+            q.offset = r.timestamp - earliest;
+            queries.push_back(q);
+        }
+    } else {
+        ifstream file(path);
+        if (!file) {
+            std::cerr << "Cannot open " << path << std::endl;
+            return 1;
+        }
+        string line;
+        int lineNo = 0;
+        while (getline(file, line)) {
+            lineNo++;
+            if (line.empty() || line[0] == '#')
+                continue;
+            istringstream in(line);
+            string source, target, clock;
+            int type, weather;
+            Query q;
+            if (!(in >> source >> target >> type >> clock >> weather) || !parseClockTime(clock, q.departure)) {
+                std::cerr << path << ":" << lineNo << ": malformed query" << std::endl;
+                return 1;
+            }
+            q.profile = campusProfile(type, weather);
+            q.source = router->resolveNode(source, q.profile);
+            q.target = router->resolveNode(target, q.profile);
+            if (q.source < 0 || q.target < 0) {
+                std::cerr << path << ":" << lineNo << ": invalid node" << std::endl;
+                return 1;
+            }
+            q.offset = 0;
+            queries.push_back(q);
+        }
+    }
+    if (queries.empty()) {
+        std::cerr << "No queries in " << path << std::endl;
+        return 1;
+    }
+    // Replay in recorded order; span runs from the earliest query to the latest
+    stable_sort(queries.begin(), queries.end(), [](const Query& a, const Query& b) { return a.offset < b.offset; });
+    long long span = queries.back().offset;
+
+    // Workers claim queries in order from a shared counter. In paced mode a worker
+    // waits for the claimed query's send time first.
+    size_t total = queries.size() * rounds;
+    vector<double> latencies(total);
+    vector<unsigned long long> hashes(total);
+    atomic<size_t> next(0);
+    auto begin = chrono::steady_clock::now();
+    auto worker = [&]() {
+        RouteResult route;
+        string text;
+        while (true) {
+            size_t i = next.fetch_add(1);
+            if (i >= total)
+                return;
+            size_t round = i / queries.size();
+            const Query& q = queries[i % queries.size()];
+            auto start = chrono::steady_clock::now();
+            if (speed > 0) {
+                double sendUs = (round * (span + 1) + q.offset) / speed;
+                auto scheduled = begin + chrono::microseconds((long long)sendUs);
+                // Sleeping overshoots by tens of us, so sleep to just before the send
+                // time and spin the rest; otherwise the replayer adds its own latency
+                this_thread::sleep_until(scheduled - chrono::microseconds(200));
+                while (chrono::steady_clock::now() < scheduled)
+                    this_thread::yield();
+                start = scheduled;
+            }
+            router->route(q.source, q.target, q.profile, q.departure, route);
+            formatRoute(route, text);
+            latencies[i] = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+            unsigned long long hash = 1469598103934665603ULL;
+            for (char c : text)
+                hash = (hash ^ (unsigned char)c) * 1099511628211ULL;
+            hashes[i] = hash;
+        }
+    };
+    vector<thread> pool;
+    for (int t = 1; t < threadCount; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (thread& t : pool)
+        t.join();
+    auto end = chrono::steady_clock::now();
+
+    // The checksum sums the hash of every answer, so it changes whenever a route
+    // does and does not depend on which thread answered
+    unsigned long long checksum = 0;
+    for (unsigned long long h : hashes)
+        checksum += h;
+
+    double seconds = chrono::duration<double>(end - begin).count();
+    cout << "Replayed " << queries.size() << " queries x " << rounds << " rounds in " << seconds * 1000 << " ms";
+    if (speed > 0)
+        cout << " (recorded span " << span / 1000.0 << " ms, speed " << speed << "x)";
+    cout << " on " << threadCount << " thread" << (threadCount > 1 ? "s" : "") << endl;
+    cout << "Throughput: " << total / seconds << " queries/s, " << seconds * 1e6 / total << " us per query" << endl;
+    printLatencyDistribution(cout, latencies);
+    cout << "Checksum: " << hex << checksum << dec << endl;
+    return 0;
+}
+
+#ifdef __linux__
+// ---------------------------------------------------------------------------
+// Built-in HTTP/1.1 server (--serve), so the kiosk stack can run as one process
+// without Express and a pathfinder process per request. A fixed pool of worker
+// threads each runs its own epoll loop on a SO_REUSEPORT listening socket, so a
+// connection stays on one thread for its whole keep-alive life and no request is
+// handed between threads. Files under public/ are read once at startup and sent
+// straight from that cache with writev. The workers share one immutable Router
+// without locks.
+// ---------------------------------------------------------------------------
+
+// Values of a flat JSON object such as {"start": "12", "time": 9}. Strings are
+// unescaped, numbers and literals are kept as written. Nested values are rejected.
+bool parseJsonObject(const string& text, map<string, string>& fields) {
+    size_t i = 0;
+    auto skipSpace = [&]() {
+        while (i < text.size() && isspace((unsigned char)text[i]))
+            i++;
+    };
+    auto parseString = [&](string& value) {
+        if (i >= text.size() || text[i] != '"')
+            return false;
+        for (i++; i < text.size() && text[i] != '"'; i++) {
+            if (text[i] != '\\') {
+                value += text[i];
+                continue;
+            }
+            if (++i >= text.size())
+                return false;
+            switch (text[i]) {
+                case 'n': value += '\n'; break;
+                case 't': value += '\t'; break;
+                case 'r': value += '\r'; break;
+                case 'b': value += '\b'; break;
+                case 'f': value += '\f'; break;
+                case 'u': value += '?'; i += 4; break;  // Node ids and numbers never need \u escapes
+                default: value += text[i]; break;
+            }
+        }
+        return i++ < text.size();
+    };
+
+    skipSpace();
+    if (i >= text.size() || text[i++] != '{')
+        return false;
+    skipSpace();
+    if (i < text.size() && text[i] == '}')
+        return true;
+    while (i < text.size()) {
+        string key, value;
+        skipSpace();
+        if (!parseString(key))
+            return false;
+        skipSpace();
+        if (i >= text.size() || text[i++] != ':')
+            return false;
+        skipSpace();
+        if (i < text.size() && text[i] == '"') {
+            if (!parseString(value))
+                return false;
+        } else {
+            size_t start = i;
+            while (i < text.size() && text[i] != ',' && text[i] != '}')
+                i++;
+            value = text.substr(start, i - start);
+            while (!value.empty() && isspace((unsigned char)value.back()))
+                value.pop_back();
+            if (value.empty() || value[0] == '{' || value[0] == '[')
+                return false;
+        }
+        fields[key] = value;
+        skipSpace();
+        if (i < text.size() && text[i] == ',') {
+            i++;
+            continue;
+        }
+        return i < text.size() && text[i] == '}';
+    }
+    return false;
+}
+
+string jsonEscape(const string& text) {
+    string escaped;
+    for (char ch : text) {
+        switch (ch) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if ((unsigned char)ch < 0x20) {
+                    char buf[8];
+                    snprintf(buf, sizeof(buf), "\\u%04x", ch);
+                    escaped += buf;
+                } else {
+                    escaped += ch;
+                }
+        }
+    }
+    return escaped;
+}
+
+// stdout of the CLI with trailing whitespace removed, like server.js sends it
+string trimmed(const string& text) {
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return end == string::npos ? string() : text.substr(0, end + 1);
+}
+
+// A field as an int; throws std::invalid_argument / std::out_of_range like std::stoi
+int intField(map<string, string>& fields, const string& key) {
+    auto it = fields.find(key);
+    if (it == fields.end())
+        throw std::invalid_argument(key);
+    return std::stoi(it->second);
+}
+
+// /findpath: {start, end, type, time, weather} -> profile, node numbers and
+// departure time. Returns 1 for a valid query, 0 when no profile matches (empty
+// result, like the CLI) and -1 with an error message for invalid input.
+int parseRouteFields(const Router& router, map<string, string>& fields, int& profile, int& sourceNode,
+                     int& targetNode, int& departure, string& error) {
+    try {
+        profile = campusProfile(intField(fields, "type"), intField(fields, "weather"));
+        if (!parseClockTime(fields["time"], departure)) {
+            error = "Invalid time";
+            return -1;
+        }
+        if (profile < 0)
+            return 0;
+        sourceNode = router.resolveNode(fields["start"], profile);
+        if (sourceNode < 0) {
+            error = "Invalid source node";
+            return -1;
+        }
+        targetNode = router.resolveNode(fields["end"], profile);
+        if (targetNode < 0) {
+            error = "Invalid target node";
+            return -1;
+        }
+        return 1;
+    } catch (const std::exception&) {
+        error = "Invalid request fields";
+        return -1;
+    }
+}
+
+// "priority": "emergency" or "kiosk" (the default)
+bool parsePriority(map<string, string>& fields, int& priority) {
+    auto it = fields.find("priority");
+    priority = PRIORITY_KIOSK;
+    if (it == fields.end() || it->second == "kiosk")
+        return true;
+    if (it->second != "emergency")
+        return false;
+    priority = PRIORITY_EMERGENCY;
+    return true;
+}
+
+// /nearest: {start, category, k, type, time, weather, access} -> the query of a
+// NearestJob, all but its priority and waiter. Returns 1, 0 or -1 like
+// parseRouteFields.
+int parseNearestFields(const Router& router, map<string, string>& fields, NearestJob& job, string& error) {
+    try {
+        if (!parseFacility(fields["category"], job.category)) {
+            error = "Unknown facility category";
+            return -1;
+        }
+        job.name = fields["category"];
+        job.k = fields.count("k") ? intField(fields, "k") : 1;
+        job.profile = campusProfile(intField(fields, "type"), intField(fields, "weather"));
+        if (!parseClockTime(fields["time"], job.departure)) {
+            error = "Invalid time";
+            return -1;
+        }
+        if (job.profile < 0)
+            return 0;
+        job.source = router.resolveNode(fields["start"], job.profile);
+        if (job.source < 0) {
+            error = "Invalid source node";
+            return -1;
+        }
+        if (!parseAccessNeed(fields.count("access") ? fields["access"] : "any", job.avoid)) {
+            error = "Unknown access need";
+            return -1;
+        }
+        return 1;
+    } catch (const std::exception&) {
+        error = "Invalid request fields";
+        return -1;
+    }
+}
+
+// Static files under the public directory, read once at startup
+class StaticFile {
+public:
+    string contentType;
+    string body;
+};
+
+string contentTypeFor(const string& name) {
+    size_t dot = name.rfind('.');
+    string ext = dot == string::npos ? "" : name.substr(dot + 1);
+    if (ext == "html")
+        return "text/html; charset=utf-8";
+    if (ext == "js")
+        return "application/javascript; charset=utf-8";
+    if (ext == "css")
+        return "text/css; charset=utf-8";
+    if (ext == "json")
+        return "application/json; charset=utf-8";
+    if (ext == "jpg" || ext == "jpeg")
+        return "image/jpeg";
+    if (ext == "png")
+        return "image/png";
+    return "application/octet-stream";
+}
+
+map<string, StaticFile> loadStaticFiles(const string& dir) {
+    map<string, StaticFile> files;
+    DIR* d = opendir(dir.c_str());
+    if (d == nullptr)
+        return files;
+    while (struct dirent* entry = readdir(d)) {
+        string name = entry->d_name;
+        string path = dir + "/" + name;
+        struct stat st;
+        if (name[0] == '.' || stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+            continue;
+        ifstream in(path, ios::binary);
+        StaticFile file;
+        file.contentType = contentTypeFor(name);
+        file.body.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        files["/" + name] = file;
+    }
+    closedir(d);
+    files["/"] = files["/index.html"];
+    return files;
+}
+
+const int IDLE_TIMEOUT_SECONDS = 30;
+const double STREAM_SUBOPTIMALITY = 1.5;   // Default bound on the early route of /findpath/stream
+
+// One client connection owned by a single worker
+class HttpConnection {
+public:
+    int fd;
+    string in;                      // Received bytes not parsed yet
+    deque<string> owned;            // Response bytes built for this connection
+    deque<iovec> out;               // Pending output, pointing into owned or the static file cache
+    bool closeAfterWrite;
+    bool peerClosed;                // Peer finished sending; close once everything is answered
+    unsigned long long id;
+    bool awaiting;                  // A route query is with the scheduler; later requests wait so responses stay in order
+    bool awaitKeepAlive;
+    bool streaming;                 // The header of a chunked response is sent, its last chunk is not
+    shared_ptr<StreamCancel> cancel;  // Set while a progressive query runs for this connection
+    chrono::steady_clock::time_point lastActive;
+
+    HttpConnection() : fd(-1), closeAfterWrite(false), peerClosed(false), id(0), awaiting(false), awaitKeepAlive(false), streaming(false) {}
+};
+
+// Take one complete request off the front of in.
+// Returns 1 when a request was parsed, 0 when more bytes are needed and -1 for a bad request.
+int parseHttpRequest(string& in, HttpRequest& req) {
+    size_t headerEnd = in.find("\r\n\r\n");
+    if (headerEnd == string::npos)
+        return in.size() > MAX_HEADER_BYTES ? -1 : 0;
+
+    istringstream head(in.substr(0, headerEnd));
+    string requestLine, version;
+    getline(head, requestLine);
+    istringstream line(requestLine);
+    if (!(line >> req.method >> req.path >> version))
+        return -1;
+    req.http11 = version == "HTTP/1.1";
+    req.keepAlive = req.http11;
+
+    size_t contentLength = 0;
+    string header;
+    while (getline(head, header)) {
+        size_t colon = header.find(':');
+        if (colon == string::npos)
+            continue;
+        string name = header.substr(0, colon);
+        string value = trimmed(header.substr(colon + 1));
+        value.erase(0, value.find_first_not_of(" \t"));
+        transform(name.begin(), name.end(), name.begin(), ::tolower);
+        transform(value.begin(), value.end(), value.begin(), ::tolower);
+        if (name == "content-length") {
+            try {
+                contentLength = std::stoul(value);
+            } catch (const std::exception&) {
+                return -1;
+            }
+        } else if (name == "connection") {
+            if (value == "close")
+                req.keepAlive = false;
+            else if (value == "keep-alive")
+                req.keepAlive = true;
+        }
+    }
+    if (contentLength > MAX_BODY_BYTES)
+        return -1;
+    if (in.size() < headerEnd + 4 + contentLength)
+        return 0;
+
+    req.body = in.substr(headerEnd + 4, contentLength);
+    size_t query = req.path.find('?');
+    if (query != string::npos)
+        req.path.erase(query);
+    in.erase(0, headerEnd + 4 + contentLength);
+    return 1;
+}
+
+const char* statusText(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 503: return "Service Unavailable";
+        default: return "Internal Server Error";
+    }
+}
+
+// Queue a response. The body is either built here (owned) or a cached static
+// file, which is referenced in place rather than copied.
+void queueResponse(HttpConnection& conn, int status, const string& contentType, const string* cachedBody,
+                   string body, bool keepAlive, bool headOnly) {
+    const string& payload = cachedBody != nullptr ? *cachedBody : body;
+    ostringstream header;
+    header << "HTTP/1.1 " << status << " " << statusText(status) << "\r\n"
+           << "Content-Type: " << contentType << "\r\n"
+           << "Content-Length: " << payload.size() << "\r\n"
+           << (keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n") << "\r\n";
+    conn.owned.push_back(header.str());
+    conn.out.push_back(iovec{(void*)conn.owned.back().data(), conn.owned.back().size()});
+    if (!headOnly && !payload.empty()) {
+        if (cachedBody == nullptr) {
+            conn.owned.push_back(std::move(body));
+            conn.out.push_back(iovec{(void*)conn.owned.back().data(), conn.owned.back().size()});
+        } else {
+            conn.out.push_back(iovec{(void*)cachedBody->data(), cachedBody->size()});
+        }
+    }
+    if (!keepAlive)
+        conn.closeAfterWrite = true;
+}
+
+void queueJson(HttpConnection& conn, int status, const string& key, const string& value, bool keepAlive) {
+    queueResponse(conn, status, "application/json; charset=utf-8", nullptr,
+                  "{\"" + key + "\":\"" + jsonEscape(value) + "\"}", keepAlive, false);
+}
+
+// One result of a progressive query as a chunk of an NDJSON response. The header
+// goes out with the first result, and the terminating empty chunk with the last.
+void queueStreamLine(HttpConnection& conn, const string& result, bool last) {
+    string data;
+    if (!conn.streaming) {
+        data = "HTTP/1.1 200 OK\r\n"
+               "Content-Type: application/x-ndjson; charset=utf-8\r\n"
+               "Transfer-Encoding: chunked\r\n"
+               "Cache-Control: no-cache\r\n";
+        data += conn.awaitKeepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+        conn.streaming = true;
+    }
+    string line = "{\"result\":\"" + jsonEscape(result) + "\",\"optimal\":" + (last ? "true" : "false") + "}\n";
+    char size[16];
+    snprintf(size, sizeof(size), "%zx\r\n", line.size());
+    data += size;
+    data += line;
+    data += "\r\n";
+    if (last) {
+        data += "0\r\n\r\n";
+        conn.streaming = false;
+        if (!conn.awaitKeepAlive)
+            conn.closeAfterWrite = true;
+    }
+    conn.owned.push_back(std::move(data));
+    conn.out.push_back(iovec{(void*)conn.owned.back().data(), conn.owned.back().size()});
+}
+
+// What the server workers share: the router, the static file cache, the scheduler
+// and the query log, if any
+class ServerContext {
+public:
+    const Router& router;
+    map<string, StaticFile>& files;
+    QueryScheduler& scheduler;
+    QueryLog* queryLog;
+};
+
+void handleHttpRequest(HttpRequest& req, HttpConnection& conn, ServerContext& server, WorkerInbox& inbox) {
+    if (req.method == "POST" && (req.path == "/findpath" || req.path == "/findpath/stream" || req.path == "/nearest")) {
+        map<string, string> fields;
+        string error;
+        if (!parseJsonObject(req.body, fields)) {
+            queueJson(conn, 400, "error", "Malformed JSON body", req.keepAlive);
+            return;
+        }
+
+        // /findpath/stream: {..., suboptimality} answers with NDJSON lines, a quick
+        // route first and then the optimal one
+        double suboptimality = STREAM_SUBOPTIMALITY;
+        if (fields.count("suboptimality")) {
+            if (!parseDoubleArg(fields["suboptimality"], suboptimality, 1, 10)) {
+                queueJson(conn, 400, "error", "Invalid suboptimality", req.keepAlive);
+                return;
+            }
+        }
+        // Optional on every query endpoint: "priority" (see QueryPriority) and
+        // "access" ("wheelchair" for step-free routes)
+        int priority, avoid;
+        if (!parsePriority(fields, priority)) {
+            queueJson(conn, 400, "error", "Unknown priority", req.keepAlive);
+            return;
+        }
+        if (!parseAccessNeed(fields.count("access") ? fields["access"] : "any", avoid)) {
+            queueJson(conn, 400, "error", "Unknown access need", req.keepAlive);
+            return;
+        }
+        if (req.path == "/nearest") {
+            NearestJob job;
+            int valid = parseNearestFields(server.router, fields, job, error);
+            if (valid < 0) {
+                queueJson(conn, 400, "error", error, req.keepAlive);
+            } else if (valid == 0) {
+                queueJson(conn, 200, "result", "", req.keepAlive);
+            } else {
+                job.priority = priority;
+                job.waiter = RouteWaiter{&inbox, conn.fd, conn.id};
+                if (!server.scheduler.submitNearest(job)) {
+                    queueJson(conn, 503, "error", "Server busy, try again shortly", req.keepAlive);
+                    return;
+                }
+                conn.awaiting = true;
+                conn.awaitKeepAlive = req.keepAlive;
+            }
+            return;
+        }
+        int profile, sourceNode, targetNode, departure;
+        int valid = parseRouteFields(server.router, fields, profile, sourceNode, targetNode, departure, error);
+        if (valid < 0) {
+            queueJson(conn, 400, "error", error, req.keepAlive);
+        } else if (valid == 0) {
+            queueJson(conn, 200, "result", "", req.keepAlive);
+        } else {
+            if (server.queryLog)
+                server.queryLog->record(sourceNode, targetNode, departure, intField(fields, "type"), intField(fields, "weather"));
+            RouteWaiter waiter{&inbox, conn.fd, conn.id};
+            bool admitted;
+            if (req.path == "/findpath/stream" && req.http11) {
+                conn.cancel = make_shared<StreamCancel>();
+                admitted = server.scheduler.submitStream(StreamJob{priority, profile, avoid, sourceNode, departure, targetNode,
+                                                                   suboptimality, waiter, conn.cancel, {}});
+            } else {
+                admitted = server.scheduler.submit(priority, profile, avoid, sourceNode, departure, targetNode, waiter);
+            }
+            if (!admitted) {
+                conn.cancel.reset();
+                queueJson(conn, 503, "error", "Server busy, try again shortly", req.keepAlive);
+                return;
+            }
+            conn.awaiting = true;
+            conn.awaitKeepAlive = req.keepAlive;
+        }
+        return;
+    }
+    if (req.method == "GET" || req.method == "HEAD") {
+        auto it = server.files.find(req.path);
+        if (it == server.files.end()) {
+            queueResponse(conn, 404, "text/plain; charset=utf-8", nullptr, "Not Found", req.keepAlive, req.method == "HEAD");
+            return;
+        }
+        queueResponse(conn, 200, it->second.contentType, &it->second.body, "", req.keepAlive, req.method == "HEAD");
+        return;
+    }
+    queueResponse(conn, 405, "text/plain; charset=utf-8", nullptr, "Method Not Allowed", req.keepAlive, false);
+}
+
+// Write as much pending output as the socket takes. Returns false if the
+// connection failed and should be closed.
+bool flushConnection(HttpConnection& conn) {
+    while (!conn.out.empty()) {
+        iovec batch[16];
+        int count = 0;
+        for (auto it = conn.out.begin(); it != conn.out.end() && count < 16; ++it)
+            batch[count++] = *it;
+        ssize_t written = writev(conn.fd, batch, count);
+        if (written < 0)
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        while (written > 0) {
+            iovec& front = conn.out.front();
+            if ((size_t)written >= front.iov_len) {
+                written -= front.iov_len;
+                conn.out.pop_front();
+            } else {
+                front.iov_base = (char*)front.iov_base + written;
+                front.iov_len -= written;
+                written = 0;
+            }
+        }
+    }
+    conn.owned.clear();
+    return true;
+}
+
+int openListenSocket(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (fd < 0)
+        return -1;
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Event loop of one worker: accepts on its own listening socket and serves those
+// connections until they close or sit idle past IDLE_TIMEOUT_SECONDS. Route answers
+// from the scheduler arrive through the worker's inbox.
+void serveWorker(int listenFd, ServerContext& server) {
+    int ep = epoll_create1(0);
+    WorkerInbox inbox;
+    epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = listenFd;
+    epoll_ctl(ep, EPOLL_CTL_ADD, listenFd, &ev);
+    ev.data.fd = inbox.eventFd;
+    epoll_ctl(ep, EPOLL_CTL_ADD, inbox.eventFd, &ev);
+    unordered_map<int, HttpConnection> conns;
+    unsigned long long nextConnId = 1;
+    epoll_event events[64];
+    char buf[16384];
+
+    auto closeConn = [&](int fd) {
+        auto it = conns.find(fd);
+        if (it != conns.end() && it->second.cancel) {
+            it->second.cancel->disconnected.store(true, memory_order_relaxed);
+            it->second.cancel->stop.store(true, memory_order_relaxed);
+        }
+        epoll_ctl(ep, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        conns.erase(fd);
+    };
+
+    // Answer buffered requests until one has to wait for the scheduler
+    auto processInput = [&](HttpConnection& conn) {
+        HttpRequest req;
+        int parsed;
+        while (!conn.awaiting && !conn.closeAfterWrite && (parsed = parseHttpRequest(conn.in, req)) != 0) {
+            if (parsed < 0) {
+                queueResponse(conn, 400, "text/plain; charset=utf-8", nullptr, "Bad Request", false, false);
+                break;
+            }
+            handleHttpRequest(req, conn, server, inbox);
+        }
+    };
+
+    // Send what is pending, then close the connection or wait for the next event
+    auto settle = [&](HttpConnection& conn) {
+        if (!flushConnection(conn) || (conn.out.empty() && !conn.awaiting && (conn.closeAfterWrite || conn.peerClosed))) {
+            closeConn(conn.fd);
+            return;
+        }
+        epoll_event mev;
+        mev.events = (conn.peerClosed ? 0u : uint32_t(EPOLLIN | EPOLLRDHUP)) | (conn.out.empty() ? 0u : uint32_t(EPOLLOUT));
+        mev.data.fd = conn.fd;
+        epoll_ctl(ep, EPOLL_CTL_MOD, conn.fd, &mev);
+    };
+
+    while (true) {
+        int n = epoll_wait(ep, events, 64, 1000);
+        auto now = chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == listenFd) {
+                int client;
+                while ((client = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK)) >= 0) {
+                    int one = 1;
+                    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                    HttpConnection& conn = conns[client];
+                    conn.fd = client;
+                    conn.id = nextConnId++;
+                    conn.lastActive = now;
+                    epoll_event cev;
+                    cev.events = EPOLLIN | EPOLLRDHUP;
+                    cev.data.fd = client;
+                    epoll_ctl(ep, EPOLL_CTL_ADD, client, &cev);
+                }
+                continue;
+            }
+
+            if (fd == inbox.eventFd) {
+                uint64_t count;
+                if (read(inbox.eventFd, &count, sizeof(count)) < 0) {
+                    // Spurious wake-up; the inbox is drained below either way
+                }
+                vector<RouteCompletion> done;
+                {
+                    lock_guard<mutex> guard(inbox.lock);
+                    done.swap(inbox.items);
+                }
+                for (RouteCompletion& completion : done) {
+                    auto found = conns.find(completion.fd);
+                    if (found == conns.end() || found->second.id != completion.connId)
+                        continue;  // Client went away while the query was running
+                    HttpConnection& conn = found->second;
+                    conn.lastActive = now;
+                    if (completion.shed) {
+                        conn.cancel.reset();
+                        queueJson(conn, 503, "error", completion.result, conn.awaitKeepAlive);
+                    } else if (completion.stream) {
+                        queueStreamLine(conn, completion.result, completion.last);
+                        if (!completion.last) {
+                            settle(conn);
+                            continue;
+                        }
+                        conn.cancel.reset();
+                    } else {
+                        queueJson(conn, 200, "result", completion.result, conn.awaitKeepAlive);
+                    }
+                    conn.awaiting = false;
+                    processInput(conn);
+                    settle(conn);
+                }
+                continue;
+            }
+
+            auto found = conns.find(fd);
+            if (found == conns.end())
+                continue;
+            HttpConnection& conn = found->second;
+            conn.lastActive = now;
+
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                bool failed = false;
+                while (true) {
+                    ssize_t got = read(fd, buf, sizeof(buf));
+                    if (got > 0) {
+                        conn.in.append(buf, got);
+                        continue;
+                    }
+                    if (got == 0)
+                        conn.peerClosed = true;  // Answers to requests already received are still sent
+                    else if (errno != EAGAIN && errno != EWOULDBLOCK)
+                        failed = true;
+                    break;
+                }
+                // A progressive query is abandoned as soon as its client hangs up
+                if (failed || (conn.peerClosed && conn.cancel)) {
+                    closeConn(fd);
+                    continue;
+                }
+                processInput(conn);
+            }
+            settle(conn);
+        }
+
+        vector<int> idle;
+        for (auto& entry : conns) {
+            if (!entry.second.awaiting && now - entry.second.lastActive > chrono::seconds(IDLE_TIMEOUT_SECONDS))
+                idle.push_back(entry.first);
+        }
+        for (int fd : idle)
+            closeConn(fd);
+    }
+}
+
+// --serve <port> [workers] [public_dir] [batch_window_us] [queue_limit] [kiosk_max_expansions]
+int serveMain(int argc, char* argv[], const string& order, QueryLog* queryLog) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " --serve <port> [workers] [public_dir] [batch_window_us] [queue_limit] [kiosk_max_expansions]" << std::endl;
+        return 1;
+    }
+    int port;
+    int workers = max(1u, thread::hardware_concurrency());
+    string publicDir = argc > 4 ? argv[4] : "public";
+    int batchWindow = 1000;
+    int queueLimit = AdmissionLimits().maxQueued;
+    AdmissionLimits admission;
+    if (!parseIntArg(argv[2], port, 1, 65535) || (argc > 3 && !parseIntArg(argv[3], workers, 1, MAX_THREADS)) ||
+        (argc > 5 && !parseIntArg(argv[5], batchWindow, 0, 1000000)) ||
+        (argc > 6 && !parseIntArg(argv[6], queueLimit, 1, INT_MAX)) ||
+        (argc > 7 && !parseLongArg(argv[7], admission.maxExpansions[PRIORITY_KIOSK], 0, LLONG_MAX))) {
+        std::cerr << "Usage: " << argv[0] << " --serve <port> [workers] [public_dir] [batch_window_us] [queue_limit] [kiosk_max_expansions]" << std::endl;
+        std::cerr << "port 1-65535, workers 1-" << MAX_THREADS << ", batch_window_us 0-1000000, queue_limit at least 1,"
+                  << " kiosk_max_expansions at least 0 (0 for no limit)" << std::endl;
+        return 1;
+    }
+    admission.maxQueued = queueLimit;
+
+    signal(SIGPIPE, SIG_IGN);
+    RouterOptions options;
+    options.order = order;
+    shared_ptr<const Router> router = Router::load(options);
+    map<string, StaticFile> files = loadStaticFiles(publicDir);
+
+    // Every socket is opened before any thread starts, so a failure can still return
+    vector<int> listenFds;
+    for (int i = 0; i < workers; ++i) {
+        int listenFd = openListenSocket(port);
+        if (listenFd < 0) {
+            std::cerr << "Cannot listen on port " << port << ": " << strerror(errno) << std::endl;
+            for (int fd : listenFds)
+                close(fd);
+            return 1;
+        }
+        listenFds.push_back(listenFd);
+    }
+
+    QueryScheduler scheduler(*router, workers, chrono::microseconds(batchWindow), 64, admission);
+    ServerContext server{*router, files, scheduler, queryLog};
+    vector<thread> pool;
+    for (int listenFd : listenFds)
+        pool.emplace_back(serveWorker, listenFd, std::ref(server));
+    cout << "Server running at http://localhost:" << port << " with " << workers << " workers" << endl;
+    for (thread& t : pool)
+        t.join();
+    return 0;
+}
+#else
+int serveMain(int argc, char* argv[], const string& order, QueryLog* queryLog) {
+    std::cerr << "The built-in server needs Linux (epoll); use server.js instead" << std::endl;
+    return 1;
+}
+#endif
+
+// Command line entry point. The CLI and the benchmark tool link the engine library
+// and call this; main() below is only compiled for the single-file build.
+int pathfinderMain(int argc, char* argv[]) {
+    // Optional leading "--order none|bfs|rcm|hilbert" renumbers the graph before the
+    // query, "--query-log <file>" appends route queries to a query log,
+    // "--max-expansions <n>" gives the search an expansion budget and
+    // "--access any|wheelchair" keeps routes and nearest facilities step-free
+    string order = "none";
+    unique_ptr<QueryLog> queryLog;
+    QueryLimits limits;
+    while (argc > 2 && (string(argv[1]) == "--order" || string(argv[1]) == "--query-log" ||
+                        string(argv[1]) == "--max-expansions" || string(argv[1]) == "--access")) {
+        if (string(argv[1]) == "--access") {
+            if (!parseAccessNeed(argv[2], limits.avoid)) {
+                std::cerr << "Unknown access need: " << argv[2] << std::endl;
+                return 1;
+            }
+        } else if (string(argv[1]) == "--max-expansions") {
+            if (!parseLongArg(argv[2], limits.maxExpansions, 0, LLONG_MAX)) {
+                std::cerr << "Invalid expansion budget: " << argv[2] << std::endl;
+                return 1;
+            }
+        } else if (string(argv[1]) == "--order") {
+            order = argv[2];
+            if (!knownNodeOrder(order)) {
+                std::cerr << "Unknown node order: " << order << std::endl;
+                return 1;
+            }
+        } else {
+            queryLog.reset(new QueryLog(argv[2]));
+            if (!queryLog->isOpen()) {
+                std::cerr << "Cannot open query log " << argv[2] << std::endl;
+                return 1;
+            }
+        }
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+
+    if (argc > 1 && string(argv[1]) == "--nearest") {
+        return nearestMain(argc, argv, order, limits);
+    }
+    if (argc > 1 && string(argv[1]) == "--matrix") {
+        return matrixMain(argc, argv, order, limits);
+    }
+    if (argc > 1 && string(argv[1]) == "--replay") {
+        return replayMain(argc, argv, order);
+    }
+    if (argc > 1 && string(argv[1]) == "--serve") {
+        return serveMain(argc, argv, order, queryLog.get());
+    }
+    if (argc != 6) {
+        std::cerr << "Usage: " << argv[0] << " [--order none|bfs|rcm|hilbert] [--query-log <file>] [--max-expansions <n>] [--access any|wheelchair] <source_node|x,y> <target_node|x,y> <type> <time> <weather>" << std::endl;
+        return 1;
+    }
+
+    int typeNode, weather_type;
+    if (!parseIntArg(argv[3], typeNode) || !parseIntArg(argv[5], weather_type)) {
+        std::cerr << "Invalid type or weather: " << argv[3] << " " << argv[5] << std::endl;
+        return 1;
+    }
+    int departure;
+    if (!parseClockTime(argv[4], departure)) {
+        std::cerr << "Invalid time: " << argv[4] << std::endl;
+        return 1;
+    }
+
+    RouterOptions options;
+    options.order = order;
+    options.lazy = true;
+    shared_ptr<const Router> router = Router::load(options);
+    int profile = campusProfile(typeNode, weather_type);
+    int sourceNode = router->resolveNode(argv[1], profile);
+    if (sourceNode < 0) {
+        std::cerr << "Invalid source node: " << argv[1] << std::endl;
+        return 1;
+    }
+    int targetNode = router->resolveNode(argv[2], profile);
+    if (targetNode < 0) {
+        std::cerr << "Invalid target node: " << argv[2] << std::endl;
+        return 1;
+    }
+    if (queryLog)
+        queryLog->record(sourceNode, targetNode, departure, typeNode, weather_type);
+
+    RouteResult route;
+    string text;
+    router->route(sourceNode, targetNode, profile, departure, route, limits);
+    formatRoute(route, text);
+    cout << text;
+
+    return 0;
+}
+
+#ifndef PATHFINDER_NO_MAIN
+int main(int argc, char* argv[]) {
+    return pathfinderMain(argc, argv);
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,201 @@
+// Routing engine API.
+//
+// A Router holds the campus graph of every travel profile together with its
+// spatial and facility indexes. Router::load builds everything up front, or each
+// profile on its first query with RouterOptions::lazy. A profile is built once
+// and only read afterwards, so one instance can be shared by any number of
+// threads without locking. Queries write into buffers owned by the caller, which
+// keep their capacity from one call to the next. Nothing here reads files or
+// writes to the console; formatRoute/formatNearest produce the text the CLI
+// prints and the server sends.
+//
+//     std::string error;
+//     std::shared_ptr<const Router> router = Router::load(RouterOptions(), &error);
+//     RouteResult route;
+//     router->route(0, 139, campusProfile(1, 0), 9 * 3600, route);
+
+#ifndef PATHFINDER_H
+#define PATHFINDER_H
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Travel profiles of the campus graph. The time of day does not pick a profile;
+// it is the departure time of a time-dependent search.
+enum CampusProfile {
+    PROFILE_CAR,                // type 0
+    PROFILE_WALK_RAIN,          // type 1, rainy season
+    PROFILE_WALK_DRY,           // type 1, dry season
+    NUM_CAMPUS_PROFILES
+};
+
+// Facility categories a node can be tagged with (bit flags, a node may carry several)
+enum Facility {
+    FACILITY_WASHROOM  = 1 << 0,
+    FACILITY_EXIT_GATE = 1 << 1,
+    FACILITY_MEDICAL   = 1 << 2,
+    FACILITY_FOOD      = 1 << 3,
+};
+const int NUM_FACILITY_CATEGORIES = 4;
+
+// Accessibility features an edge can have (bit flags, an edge may carry several).
+// A query lists the features its route must avoid.
+enum Accessibility {
+    ACCESS_STAIRS = 1 << 0,
+};
+const int NUM_ACCESS_FEATURES = 1;
+
+// Pick the travel profile for the type (0 car, 1 walk) and weather (1 rain) fields
+int campusProfile(int type, int weather);
+
+// Departure time from "H" or "H:MM" (24-hour clock) in seconds after midnight
+bool parseClockTime(const std::string& text, int& seconds);
+
+// A whole command line argument as a number in [low, high]. False for malformed or
+// out of range input, where std::stoi and friends would throw or stop early.
+bool parseIntArg(const std::string& arg, int& value, int low = INT_MIN, int high = INT_MAX);
+bool parseLongArg(const std::string& arg, long long& value, long long low, long long high);
+bool parseDoubleArg(const std::string& arg, double& value, double low, double high);
+
+// Map a category name (washroom, exit, medical, food) to its facility flag
+bool parseFacility(const std::string& name, Facility& category);
+
+// Features to avoid for an access need: "any" (none) or "wheelchair" (stairs)
+bool parseAccessNeed(const std::string& name, int& avoid);
+
+// A route, in public node numbers
+class RouteResult {
+public:
+    bool found = false;
+    int distance = 0;             // Travel time from leaving the source, when found
+    std::vector<int> path;        // Source first, target last, when found
+    bool optimal = true;          // False for the early route of routeProgressive
+    bool exhausted = false;       // The search ran out of its expansion budget
+};
+
+// Compact path encoding, for storing routes in bulk and sending them: the node
+// count, then the first node and each node's difference from the one before, as
+// zigzag varints. Consecutive nodes of a route mostly have close numbers, so a
+// hop takes one or two bytes instead of four. encodePath appends to bytes.
+void encodePath(const std::vector<int>& path, std::string& bytes);
+
+// Decode the path starting at bytes[pos] and move pos past it. Returns false for
+// truncated or malformed input.
+bool decodePath(const std::string& bytes, size_t& pos, std::vector<int>& path);
+
+// Routes kept in one byte buffer with encodePath, for caches and bulk results.
+// get() reuses the capacity of out.path, so decoding does not allocate once it
+// has grown to the longest route.
+class PackedRoutes {
+public:
+    int add(const RouteResult& route);      // Index of the route, -1 once the buffer holds 4 GiB
+    bool get(int index, RouteResult& out) const;  // False for a bad index or a route that does not decode
+    int size() const { return (int)offsets.size(); }
+    void shrink();                           // Release spare capacity once the routes are in
+    void clear();
+    size_t memoryBytes() const;
+
+private:
+    std::string bytes;
+    std::vector<uint32_t> offsets;           // Start of each route in bytes
+};
+
+// One match of a nearest-facility query
+class FacilityResult {
+public:
+    int node = -1;
+    int distance = 0;
+    std::vector<int> path;        // From the source to the facility
+};
+
+// Limits of one query. The route never uses an edge with a feature in avoid. A
+// search gives up once it has expanded maxExpansions nodes (0 for no limit): the
+// route is then not found, or not proven optimal, and exhausted is set. It also
+// gives up soon after another thread raises *cancel.
+class QueryLimits {
+public:
+    int avoid = 0;                // Accessibility flags
+    long long maxExpansions = 0;
+    const std::atomic<bool>* cancel = nullptr;
+};
+
+// Progress of a routeProgressive query that may be cancelled and run again, such
+// as a preempted server stream. Once the quick route is reported, a rerun with
+// the same state starts at the optimal search and does not report it again.
+class ProgressiveState {
+public:
+    bool quickReported = false;
+    RouteResult quick;
+};
+
+class RouterOptions {
+public:
+    std::string order = "none";   // Internal node order: none, bfs, rcm or hilbert
+    bool lazy = false;            // Build profiles on first use, for one-shot processes such as the CLI
+};
+
+class Router {
+public:
+    // Build the graphs and indexes. Returns null, with a message in *error when
+    // error is not null, if the options are invalid.
+    static std::shared_ptr<const Router> load(const RouterOptions& options, std::string* error = nullptr);
+
+    ~Router();
+
+    int nodeCount() const;
+
+    // Public node number for a node argument: a number, or a map position "x,y"
+    // snapped onto the nearest road of the profile. -1 if invalid.
+    int resolveNode(const std::string& arg, int profile) const;
+
+    // Fastest route leaving source at `departure` (seconds after midnight).
+    // Returns false for an invalid profile or node, or when cancelled; out.found
+    // tells whether the target is reachable.
+    bool route(int source, int target, int profile, int departure, RouteResult& out,
+               const QueryLimits& limits = QueryLimits()) const;
+
+    // Progressive query for large graphs. onResult first receives a quick route
+    // from weighted A*, which costs at most `suboptimality` times the optimum and
+    // has optimal false. It then receives the optimal route. An unreachable target
+    // is reported once. If the budget runs out in the second search, the quick
+    // route is reported again with exhausted set. Each search gets the whole
+    // budget. Returns false when cancelled, or for an invalid profile or node.
+    // state, if given, carries the quick route over to a rerun of the query.
+    bool routeProgressive(int source, int target, int profile, int departure, double suboptimality,
+                          const std::function<void(const RouteResult&)>& onResult,
+                          const QueryLimits& limits = QueryLimits(), ProgressiveState* state = nullptr) const;
+
+    // Routes from one source to several targets, in the order of targets. They
+    // are answered by one search where the profile allows it; the budget then
+    // covers that whole search.
+    bool routeMany(int source, const std::vector<int>& targets, int profile, int departure,
+                   std::vector<RouteResult>& out, const QueryLimits& limits = QueryLimits()) const;
+
+    // The k nearest facilities of a category from source, closest first. Returns
+    // false for an invalid profile or node, or when cancelled. A search that runs
+    // out of budget keeps the matches found so far and sets *exhausted.
+    bool nearest(int source, Facility category, int k, int profile, int departure,
+                 std::vector<FacilityResult>& out, const QueryLimits& limits = QueryLimits(),
+                 bool* exhausted = nullptr) const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl;
+
+    Router();
+};
+
+// Text of a route or nearest-facility answer, as printed by the CLI
+void formatRoute(const RouteResult& route, std::string& text);
+void formatNearest(const std::vector<FacilityResult>& matches, const std::string& name, std::string& text,
+                   bool exhausted = false);
+
+// Command line front end shared by the CLI and benchmark executables
+int pathfinderMain(int argc, char* argv[]);
+
+#endif
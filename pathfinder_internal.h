@@ -0,0 +1,1268 @@
+// Engine internals: the graph, search options, node orders, campus profiles and
+// the multi-level overlay that pathfinder.cpp is built on. The benchmarks and
+// tests of the engine use them directly; applications use the Router API of
+// pathfinder.h instead.
+
+#ifndef PATHFINDER_INTERNAL_H
+#define PATHFINDER_INTERNAL_H
+
+#include "pathfinder.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Directed arc as recorded by addEdge/addArc, before it is packed into CSR form
+class Arc {
+public:
+    int from;
+    int to;
+    int weight;
+    unsigned char profile;  // Travel-time profile, 0 for a constant cost (see Graph::travelProfiles)
+    unsigned char access;   // Accessibility features (Accessibility flags) of the arc
+
+    constexpr Arc() : from(0), to(0), weight(0), profile(0), access(0) {}
+    constexpr Arc(int u, int v, int w) : from(u), to(v), weight(w), profile(0), access(0) {}
+};
+
+// CSR arrays of a graph with N nodes and M arcs, with the same layout Graph::packArcs
+// produces. Built by packEdges in a constant expression, so a fixed graph such as
+// the campus is compiled into the binary ready to search.
+template <int N, int M>
+class StaticCsr {
+public:
+    std::array<Arc, M> arcs;                                // Insertion order, as Graph::arcs
+    std::array<int, N + 1> firstOut, firstIn;
+    std::array<int, M> head, outWeight, tail, inWeight;
+    int maxOutDegree;
+};
+
+// MinHeapNode class for storing node and f-cost
+class MinHeapNode {
+public:
+    int v;
+    int f;
+    MinHeapNode(int vertex, int cost) : v(vertex), f(cost) {}
+};
+
+// Custom MinHeap class
+class MinHeap {
+public:
+    std::vector<MinHeapNode> heap;
+
+    int parent(int i) { return (i - 1) / 2; }
+    int left(int i) { return 2 * i + 1; }
+    int right(int i) { return 2 * i + 2; }
+
+    void insert(MinHeapNode node) {
+        heap.push_back(node);
+        int i = heap.size() - 1;
+
+        while (i != 0 && heap[parent(i)].f > heap[i].f) {
+            std::swap(heap[i], heap[parent(i)]);
+            i = parent(i);
+        }
+    }
+
+    void heapify(int i) {
+        int l = left(i);
+        int r = right(i);
+        int smallest = i;
+
+        if (l < (int)heap.size() && heap[l].f < heap[smallest].f)
+            smallest = l;
+        if (r < (int)heap.size() && heap[r].f < heap[smallest].f)
+            smallest = r;
+
+        if (smallest != i) {
+            std::swap(heap[i], heap[smallest]);
+            heapify(smallest);
+        }
+    }
+
+    MinHeapNode extractMin() {
+        if (heap.size() == 1) {
+            MinHeapNode root = heap[0];
+            heap.pop_back();
+            return root;
+        }
+
+        MinHeapNode root = heap[0];
+        heap[0] = heap.back();
+        heap.pop_back();
+
+        heapify(0);
+        return root;
+    }
+
+    bool isEmpty() {
+        return heap.empty();
+    }
+};
+
+// Breakpoint of a travel-time profile. From `minute` of the day until the next
+// breakpoint, an arc costs its weight scaled by a percentage that moves linearly
+// to the next breakpoint's. A CLOSED breakpoint means the arc cannot be entered
+// until the next open breakpoint, and the wait counts as travel time. Profiles are
+// periodic over the day and shared by all arcs that use them.
+class TravelBreakpoint {
+public:
+    unsigned short minute;    // 0 .. MINUTES_PER_DAY-1, the first breakpoint of a profile is at 0
+    unsigned short percent;   // Cost in percent of the arc weight, at least 100, or CLOSED
+
+    static const unsigned short CLOSED = 0;
+};
+
+// Turn restriction or turn cost: driving from -> via -> to costs `cost` on top of
+// the arcs, or is not allowed at all when cost is TURN_FORBIDDEN. Only exceptions
+// are stored; other turns are free (see Graph::turnCost).
+class TurnRule {
+public:
+    int from, via, to;
+    int cost;
+
+    bool operator<(const TurnRule& other) const {
+        return std::tie(via, from, to) < std::tie(other.via, other.from, other.to);
+    }
+};
+
+const int TURN_FORBIDDEN = -1;
+
+const int MINUTES_PER_DAY = 24 * 60;
+const int SECONDS_PER_DAY = MINUTES_PER_DAY * 60;
+
+// Every combination of accessibility features a query can avoid
+const int NUM_ACCESS_MASKS = 1 << NUM_ACCESS_FEATURES;
+
+// INT_MAX if bit e of a packed arc bitset is set, 0 otherwise. OR-ed into the
+// label an arc would give its head, it makes a blocked arc's relaxation one that
+// never improves anything, without a branch. Labels must be non-negative.
+inline int blockedPenalty(const uint64_t* blocked, int e) {
+    return -(int)((blocked[e >> 6] >> (e & 63)) & 1) & INT_MAX;
+}
+
+// Graph class with directed, weighted arcs. Arcs are collected by addEdge/addArc and
+// packed into forward and reverse CSR (compressed sparse row) arrays by finalize(),
+// so every node's neighbours sit contiguously in memory.
+class Graph {
+public:
+    int numNodes;
+    std::vector<Arc> arcs;                      // Arcs in insertion order
+    std::vector<int> firstOut, head, outWeight; // Forward CSR: arcs leaving u are firstOut[u] .. firstOut[u+1]-1
+    std::vector<int> firstIn, tail, inWeight;   // Reverse CSR: arcs entering v are firstIn[v] .. firstIn[v+1]-1
+    std::vector<unsigned char> outProfile, inProfile; // Travel-time profile of each CSR arc
+    std::vector<std::vector<TravelBreakpoint>> travelProfiles; // Shared profiles; index 0 is the constant cost
+    std::vector<TurnRule> turnRules;            // Sorted by via node, then from and to
+    int uTurnCost;                              // Cost of turning back at a dead end, -1 when turns are not modelled
+    int packedArcs;                             // Number of arcs already packed into the CSR arrays
+    int maxOutDegree;                           // Largest number of arcs leaving one node
+    double costPerPixel;                        // Lowest arc weight per pixel of map distance, for the A* heuristic
+    int boundVersion;                           // Graph version costPerPixel was computed for
+    std::vector<unsigned char> facilities;      // Facility bit flags per node
+    std::vector<std::vector<int>> facilityNodes; // Category index: nodes tagged with each category
+    std::vector<int> x, y;                      // Pixel position of each node on map.jpg, -1 if not surveyed
+    std::vector<int> extId, intId;              // Public node number of each internal id, and back
+    std::vector<std::vector<uint64_t>> blockedOut, blockedIn; // Per feature mask, packed bitset of the CSR arcs with one of those features
+    int version;                                // Bumped on every change, used to refresh derived tables
+
+    Graph(int n) {
+        numNodes = n;
+        firstOut.resize(n + 1, 0);
+        firstIn.resize(n + 1, 0);
+        packedArcs = 0;
+        maxOutDegree = 0;
+        costPerPixel = 0;
+        boundVersion = -1;
+        facilities.resize(n, 0);
+        x.resize(n, -1);
+        y.resize(n, -1);
+        facilityNodes.resize(NUM_FACILITY_CATEGORIES);
+        travelProfiles.resize(1);
+        blockedOut.resize(NUM_ACCESS_MASKS);
+        blockedIn.resize(NUM_ACCESS_MASKS);
+        uTurnCost = -1;
+        for (int i = 0; i < n; ++i) {
+            extId.push_back(i);
+            intId.push_back(i);
+        }
+        version = 0;
+    }
+
+    // Tag a node with a facility category
+    void tagFacility(int node, Facility category) {
+        if (facilities[node] & category)
+            return;
+        facilities[node] |= category;
+        facilityNodes[facilityIndex(category)].push_back(node);
+        version++;
+    }
+
+    // Place a node on the campus map
+    void setPosition(int node, int px, int py) {
+        x[node] = px;
+        y[node] = py;
+        version++;
+    }
+
+    static int facilityIndex(Facility category) {
+        int i = 0;
+        while ((1 << i) != category)
+            i++;
+        return i;
+    }
+
+    // Add a one-way arc u -> v
+    void addArc(int u, int v, int weight) {
+        arcs.push_back(Arc(u, v, weight));
+        version++;
+    }
+
+    // Add a two-way edge with separate costs per direction (one-way lanes, uphill vs downhill)
+    void addEdge(int u, int v, int forwardWeight, int backwardWeight) {
+        addArc(u, v, forwardWeight);
+        addArc(v, u, backwardWeight);
+    }
+
+    // Add an undirected edge with the same cost both ways
+    void addEdge(int u, int v, int weight) {
+        addEdge(u, v, weight, weight);
+    }
+
+    // Take arcs already packed at compile time (see packEdges). The arrays are
+    // copied as they are, so finalize() has nothing left to pack. The graph must
+    // have N nodes and no arcs yet.
+    template <int N, int M>
+    void loadPacked(const StaticCsr<N, M>& csr) {
+        arcs.assign(csr.arcs.begin(), csr.arcs.end());
+        firstOut.assign(csr.firstOut.begin(), csr.firstOut.end());
+        firstIn.assign(csr.firstIn.begin(), csr.firstIn.end());
+        head.assign(csr.head.begin(), csr.head.end());
+        outWeight.assign(csr.outWeight.begin(), csr.outWeight.end());
+        tail.assign(csr.tail.begin(), csr.tail.end());
+        inWeight.assign(csr.inWeight.begin(), csr.inWeight.end());
+        outProfile.assign(M, 0);
+        inProfile.assign(M, 0);
+        clearAccessBits(M);
+        maxOutDegree = csr.maxOutDegree;
+        packedArcs = M;
+        version++;
+    }
+
+    // Bring the CSR arrays and the heuristic bound up to date. Searches call this on
+    // entry; it only does work when the graph changed since the last call.
+    void finalize() {
+        if (packedArcs != (int)arcs.size())
+            packArcs();
+        if (boundVersion != version)
+            computeCostPerPixel();
+    }
+
+    // Pack the arcs into the forward and reverse CSR arrays.
+    // Each node's arcs are laid out newest first, the order the original linked
+    // lists were walked in.
+    void packArcs() {
+        int m = arcs.size();
+        head.resize(m);
+        outWeight.resize(m);
+        tail.resize(m);
+        inWeight.resize(m);
+        outProfile.resize(m);
+        inProfile.resize(m);
+        std::fill(firstOut.begin(), firstOut.end(), 0);
+        std::fill(firstIn.begin(), firstIn.end(), 0);
+
+        for (const Arc& a : arcs) {
+            firstOut[a.from + 1]++;
+            firstIn[a.to + 1]++;
+        }
+        maxOutDegree = 0;
+        for (int i = 0; i < numNodes; ++i) {
+            maxOutDegree = std::max(maxOutDegree, firstOut[i + 1]);
+            firstOut[i + 1] += firstOut[i];
+            firstIn[i + 1] += firstIn[i];
+        }
+
+        std::vector<int> outPos(firstOut.begin(), firstOut.end() - 1);
+        std::vector<int> inPos(firstIn.begin(), firstIn.end() - 1);
+        clearAccessBits(m);
+        for (int i = m - 1; i >= 0; --i) {
+            const Arc& a = arcs[i];
+            int out = outPos[a.from]++, in = inPos[a.to]++;
+            head[out] = a.to;
+            outProfile[out] = a.profile;
+            outWeight[out] = a.weight;
+            tail[in] = a.from;
+            inProfile[in] = a.profile;
+            inWeight[in] = a.weight;
+            setAccessBits(blockedOut, out, a.access);
+            setAccessBits(blockedIn, in, a.access);
+        }
+        packedArcs = m;
+    }
+
+    // Accessibility bitsets, one bit per CSR arc: blockedOut[mask] has bit e set
+    // when forward arc e has any feature in mask (blockedIn likewise for the reverse
+    // arcs). A search avoiding a set of features reads a single bit per arc, however
+    // many features the set holds, and blockedOut[0] is all clear.
+    void clearAccessBits(int m) {
+        for (int mask = 0; mask < NUM_ACCESS_MASKS; ++mask) {
+            blockedOut[mask].assign((m + 63) / 64, 0);
+            blockedIn[mask].assign((m + 63) / 64, 0);
+        }
+    }
+
+    static void setAccessBits(std::vector<std::vector<uint64_t>>& blocked, int e, int features) {
+        for (int mask = 1; mask < NUM_ACCESS_MASKS; ++mask) {
+            uint64_t& word = blocked[mask][e >> 6];
+            word = (word & ~(1ULL << (e & 63))) | (uint64_t((features & mask) != 0) << (e & 63));
+        }
+    }
+
+    // Lowest weight per pixel over the arcs whose ends are both on the map, so that
+    // straight-line distance times it never overestimates a route's cost
+    void computeCostPerPixel() {
+        costPerPixel = 0;
+        bool found = false;
+        for (const Arc& a : arcs) {
+            if (x[a.from] < 0 || x[a.to] < 0)
+                continue;
+            double length = std::hypot(x[a.to] - x[a.from], y[a.to] - y[a.from]);
+            if (length == 0)
+                continue;
+            if (!found || a.weight / length < costPerPixel) {
+                costPerPixel = a.weight / length;
+                found = true;
+            }
+        }
+        boundVersion = version;
+    }
+
+    // Register a travel-time profile and return its id, or -1 when the table is not
+    // valid: breakpoints must start at minute 0 and increase, and an open breakpoint
+    // must cost at least 100% so the static A* bound still holds.
+    int addTravelProfile(const std::vector<TravelBreakpoint>& breakpoints) {
+        if (breakpoints.empty() || breakpoints[0].minute != 0 || travelProfiles.size() > 255)
+            return -1;
+        bool open = false;
+        for (size_t i = 0; i < breakpoints.size(); ++i) {
+            const TravelBreakpoint& b = breakpoints[i];
+            if (b.minute >= MINUTES_PER_DAY || (i > 0 && b.minute <= breakpoints[i - 1].minute))
+                return -1;
+            if (b.percent != TravelBreakpoint::CLOSED && b.percent < 100)
+                return -1;
+            open |= b.percent != TravelBreakpoint::CLOSED;
+        }
+        if (!open)
+            return -1;
+        travelProfiles.push_back(breakpoints);
+        return travelProfiles.size() - 1;
+    }
+
+    // True once any travel-time profile is registered
+    bool timeDependent() const {
+        return travelProfiles.size() > 1;
+    }
+
+    // Travel time of an arc with the given weight and profile when entered at time t
+    // (seconds, may run past midnight). Costs are rounded down, which keeps the
+    // FIFO property: entering later never means arriving earlier.
+    int travelTime(int weight, int profile, int t) const {
+        if (profile == 0)
+            return weight;
+        const std::vector<TravelBreakpoint>& table = travelProfiles[profile];
+        size_t n = table.size();
+        int now = t % SECONDS_PER_DAY;
+        size_t i = n - 1;
+        while (table[i].minute * 60 > now)
+            i--;
+
+        // Start of breakpoint j, where j >= n counts on into the next day
+        auto startOf = [&](size_t j) { return table[j % n].minute * 60 + (j >= n ? SECONDS_PER_DAY : 0); };
+
+        if (table[i].percent == TravelBreakpoint::CLOSED) {
+            // Wait for the next open breakpoint, then pay its cost
+            size_t j = i + 1;
+            while (table[j % n].percent == TravelBreakpoint::CLOSED)
+                j++;
+            return startOf(j) - now + (long long)weight * table[j % n].percent / 100;
+        }
+        const TravelBreakpoint& next = table[(i + 1) % n];
+        int from = table[i].percent;
+        int to = next.percent == TravelBreakpoint::CLOSED ? from : next.percent;
+        int start = startOf(i), length = startOf(i + 1) - start;
+        long long scaled = (long long)from * length + (long long)(to - from) * (now - start);
+        return (long long)weight * scaled / (100LL * length);
+    }
+
+    // Travel time of forward CSR arc e entered at time t
+    int arcTravelTime(int e, int t) const {
+        return travelTime(outWeight[e], outProfile[e], t);
+    }
+
+    // Give the arcs u -> v a travel-time profile. Returns false when there is no such
+    // arc, or when the profile's falling slopes are too steep for the arc's weight,
+    // which would let a later departure arrive earlier (FIFO violation).
+    bool setArcProfile(int u, int v, int profile) {
+        bool found = false;
+        for (Arc& a : arcs) {
+            if (a.from != u || a.to != v)
+                continue;
+            if (!fifoSafe(a.weight, profile))
+                return false;
+            a.profile = profile;
+            found = true;
+        }
+        if (!found)
+            return false;
+        if (packedArcs == (int)arcs.size()) {
+            for (int e = firstOut[u]; e < firstOut[u + 1]; ++e) {
+                if (head[e] == v)
+                    outProfile[e] = profile;
+            }
+            for (int e = firstIn[v]; e < firstIn[v + 1]; ++e) {
+                if (tail[e] == u)
+                    inProfile[e] = profile;
+            }
+        }
+        version++;
+        return true;
+    }
+
+    // Set the accessibility features of the arcs u -> v. Returns false when there
+    // is no such arc.
+    bool setArcAccess(int u, int v, int features) {
+        bool found = false;
+        for (Arc& a : arcs) {
+            if (a.from == u && a.to == v) {
+                a.access = features;
+                found = true;
+            }
+        }
+        if (!found)
+            return false;
+        if (packedArcs == (int)arcs.size()) {
+            for (int e = firstOut[u]; e < firstOut[u + 1]; ++e) {
+                if (head[e] == v)
+                    setAccessBits(blockedOut, e, features);
+            }
+            for (int e = firstIn[v]; e < firstIn[v + 1]; ++e) {
+                if (tail[e] == u)
+                    setAccessBits(blockedIn, e, features);
+            }
+        }
+        version++;
+        return true;
+    }
+
+    // Cost of the cheapest CSR arc u -> v without a feature in avoid, INT_MAX if
+    // there is none
+    int arcCost(int u, int v, int avoid = 0) const {
+        const uint64_t* blocked = blockedOut[avoid].data();
+        int best = INT_MAX;
+        for (int e = firstOut[u]; e < firstOut[u + 1]; ++e) {
+            if (head[e] == v)
+                best = std::min(best, outWeight[e] | blockedPenalty(blocked, e));
+        }
+        return best;
+    }
+
+    // Change the weight of the arcs u -> v, in the arc list and the CSR arrays.
+    // Returns false when there is no such arc.
+    bool setArcWeight(int u, int v, int weight) {
+        bool found = false;
+        for (Arc& a : arcs) {
+            if (a.from == u && a.to == v) {
+                a.weight = weight;
+                found = true;
+            }
+        }
+        if (!found)
+            return false;
+        if (packedArcs == (int)arcs.size()) {
+            for (int e = firstOut[u]; e < firstOut[u + 1]; ++e) {
+                if (head[e] == v)
+                    outWeight[e] = weight;
+            }
+            for (int e = firstIn[v]; e < firstIn[v + 1]; ++e) {
+                if (tail[e] == u)
+                    inWeight[e] = weight;
+            }
+        }
+        version++;
+        return true;
+    }
+
+    // Every falling segment of the profile must lose at most one second of cost per
+    // second of waiting for an arc of this weight
+    bool fifoSafe(int weight, int profile) const {
+        const std::vector<TravelBreakpoint>& table = travelProfiles[profile];
+        for (size_t i = 0; i < table.size(); ++i) {
+            const TravelBreakpoint& a = table[i];
+            const TravelBreakpoint& b = table[(i + 1) % table.size()];
+            if (a.percent == TravelBreakpoint::CLOSED || b.percent == TravelBreakpoint::CLOSED || b.percent >= a.percent)
+                continue;
+            int length = ((i + 1 < table.size() ? b.minute : MINUTES_PER_DAY) - a.minute) * 60;
+            if ((long long)weight * (a.percent - b.percent) > 100LL * length)
+                return false;
+        }
+        return true;
+    }
+
+    // Model turns: searches then track the arc a node was entered by, forbid turning
+    // back except at dead ends (where it costs deadEndUTurnCost), and apply the
+    // turn rules added with addTurnRule
+    void enableTurns(int deadEndUTurnCost) {
+        uTurnCost = deadEndUTurnCost;
+        version++;
+    }
+
+    bool turnsModelled() const {
+        return uTurnCost >= 0;
+    }
+
+    // Restrict (cost TURN_FORBIDDEN) or charge for the turn from -> via -> to.
+    // Returns false for any other negative cost, which the label-setting
+    // turn-aware search cannot handle.
+    bool addTurnRule(int from, int via, int to, int cost) {
+        if (cost < 0 && cost != TURN_FORBIDDEN)
+            return false;
+        TurnRule rule{from, via, to, cost};
+        auto it = std::lower_bound(turnRules.begin(), turnRules.end(), rule);
+        if (it != turnRules.end() && !(rule < *it))
+            it->cost = cost;
+        else
+            turnRules.insert(it, rule);
+        version++;
+        return true;
+    }
+
+    // Extra cost of continuing from -> via -> to, or TURN_FORBIDDEN
+    int turnCost(int from, int via, int to) const {
+        TurnRule key{from, via, to, 0};
+        auto it = std::lower_bound(turnRules.begin(), turnRules.end(), key);
+        if (it != turnRules.end() && !(key < *it))
+            return it->cost;
+        if (from == to)
+            return firstOut[via + 1] - firstOut[via] == 1 ? uTurnCost : TURN_FORBIDDEN;
+        return 0;
+    }
+
+    // Renumber the nodes for memory locality: internal node v becomes newId[v].
+    // The public node numbers stay the same through extId/intId, so callers
+    // translate at the boundary and everything in between uses internal ids.
+    void renumber(const std::vector<int>& newId) {
+        for (Arc& a : arcs) {
+            a.from = newId[a.from];
+            a.to = newId[a.to];
+        }
+        std::vector<unsigned char> oldFacilities = facilities;
+        std::vector<int> oldX = x, oldY = y, oldExt = extId;
+        for (int v = 0; v < numNodes; ++v) {
+            facilities[newId[v]] = oldFacilities[v];
+            x[newId[v]] = oldX[v];
+            y[newId[v]] = oldY[v];
+            extId[newId[v]] = oldExt[v];
+        }
+        for (int v = 0; v < numNodes; ++v)
+            intId[extId[v]] = v;
+        for (std::vector<int>& nodes : facilityNodes) {
+            for (int& node : nodes)
+                node = newId[node];
+        }
+        for (TurnRule& rule : turnRules) {
+            rule.from = newId[rule.from];
+            rule.via = newId[rule.via];
+            rule.to = newId[rule.to];
+        }
+        std::sort(turnRules.begin(), turnRules.end());
+        packedArcs = -1;
+        version++;
+        finalize();
+    }
+
+    // True if the node has any arc in either direction
+    bool hasArcs(int node) {
+        return firstOut[node] != firstOut[node + 1] || firstIn[node] != firstIn[node + 1];
+    }
+
+    // Utility to print the adjacency list (for debugging)
+    void printGraph() {
+        finalize();
+        for (int i = 0; i < numNodes; ++i) {
+            std::cout << "Node " << i << ": ";
+            for (int e = firstOut[i]; e < firstOut[i + 1]; ++e)
+                std::cout << "(" << head[e] << ", " << outWeight[e] << ") -> ";
+            std::cout << "NULL\n";
+        }
+    }
+};
+
+// Options of a search. heuristicPercent above 100 runs weighted A*: the inflated
+// heuristic expands far fewer nodes and the route found costs at most
+// heuristicPercent% of the optimum. Nodes whose lower bound exceeds upperBound, the
+// cost of a route already known, are never queued. A search that has expanded
+// maxExpansions nodes (0 for no limit) gives up and sets exhausted; this is the
+// deadline of a query, counted in work rather than time so it does not depend on
+// the load of the machine. cancel is polled every CANCEL_POLL_INTERVAL expansions;
+// once another thread raises it the search gives up and sets stopped. Arcs with any
+// of the accessibility features in avoid are never taken.
+class SearchControl {
+public:
+    int avoid = 0;
+    int heuristicPercent = 100;
+    int upperBound = INT_MAX;
+    long long maxExpansions = 0;
+    const std::atomic<bool>* cancel = nullptr;
+    bool exhausted = false;
+    bool stopped = false;
+};
+
+// A* from src to target, the time-dependent variant on graphs with travel-time
+// profiles. Returns the distance (INT_MAX if unreachable) and fills parent with
+// the search tree; control selects weighted A*, a bound, a budget or cancellation.
+int aStarSearch(Graph& graph, int src, int target, std::vector<int>& parent, int departure = 0,
+                SearchControl* control = nullptr);
+
+// A* over arcs for graphs with turns modelled (Graph::enableTurns): obeys the
+// turn rules and pays turn costs. parentArc receives the arc tree and lastArc the
+// arc that reaches target (-1 when src == target).
+int turnAwareSearch(Graph& graph, int src, int target, int departure, std::vector<int>& parentArc, int& lastArc,
+                    SearchControl* control = nullptr);
+
+// SIMD kernels in use by the searches and distanceMatrix: "scalar", "sse41" or
+// "avx2", the widest the CPU supports unless PATHFINDER_SIMD names another
+const char* simdLevelName();
+
+// Travel times between every pair of nodes leaving at `departure`, avoiding the
+// features in avoid: dist[i][v] from nodes[i] to v, INT_MAX if unreachable. Turns
+// are not modelled.
+std::vector<std::vector<int>> distanceMatrix(Graph& graph, const std::vector<int>& nodes, int departure, int avoid);
+
+// Node orderings for Graph::renumber. Each returns newId[v] for every node.
+std::vector<int> bfsOrder(Graph& graph);
+std::vector<int> rcmOrder(Graph& graph);
+std::vector<int> hilbertOrder(Graph& graph);
+
+// Renumber the graph with a named order: none, bfs, rcm or hilbert
+bool applyNodeOrder(Graph& graph, const std::string& name);
+
+const int CAMPUS_NODES = 240;   // Nodes of every campus profile
+
+// Build a campus profile with its facilities, time-of-day costs, turn rules and map
+// positions, renumbered with the given node order. Returns false when no profile
+// matches.
+bool loadCampusGraph(Graph& graph, int profile, const std::string& order);
+
+// ---------------------------------------------------------------------------
+// Multi-level overlay (customizable route planning) for graphs far larger than a
+// campus. The nodes are split into nested cells: level 0 cells hold cellSizes[0]
+// consecutive nodes of a space-filling-curve order, and every cell of level l+1 is
+// a run of whole level l cells. For each cell the overlay keeps its boundary
+// nodes and a clique of shortest distances from every entry to every exit
+// through the cell. Queries only descend into the cells of source and target, and
+// elsewhere hop across whole cells. Partitioning only depends on the topology;
+// customization (the cliques) only on the weights, so a weight change re-customizes
+// just the cells that contain the changed arcs. Overlays use the base arc weights
+// and do not model turns or travel-time profiles. An overlay customized with an
+// accessibility mask never uses an arc that has one of its features; a copy of an
+// overlay shares the partition and can be customized for another mask.
+// ---------------------------------------------------------------------------
+
+// Boundary and clique of one cell on one level
+class OverlayCell {
+public:
+    std::vector<int> entries; // Nodes with an arc coming in from another cell of this level
+    std::vector<int> exits; // Nodes with an arc going out to another cell of this level
+    std::vector<int> clique; // entries.size() x exits.size() distances through the cell, INT_MAX if none
+};
+
+class OverlayLevel {
+public:
+    int cellSize;                    // Partition ranks per cell
+    std::vector<OverlayCell> cells;
+    std::vector<int> entryIndex;     // Position of each node in its cell's entries, -1 if none
+    std::vector<int> exitIndex;      // Position of each node in its cell's exits, -1 if none
+};
+
+// Dijkstra labels that are reset in O(1) between searches by bumping a stamp, so a
+// search that touches a few cells costs nothing for the rest of a large graph
+class OverlayWorkspace {
+public:
+    std::vector<int> dist, parent, parentLevel, stamp;
+    int round;
+    MinHeap minHeap;
+
+    OverlayWorkspace(int n) : dist(n), parent(n), parentLevel(n), stamp(n, 0), round(0) {}
+
+    void reset() {
+        round++;
+        minHeap.heap.clear();
+    }
+
+    int get(int v) const {
+        return stamp[v] == round ? dist[v] : INT_MAX;
+    }
+
+    // Lower the label of v; parentLevel is -1 for a base arc or the level of a clique.
+    void improve(int v, int d, int from, int level) {
+        if (d >= get(v))
+            return;
+        stamp[v] = round;
+        dist[v] = d;
+        parent[v] = from;
+        parentLevel[v] = level;
+        minHeap.insert(MinHeapNode(v, d));
+    }
+};
+
+class MultiLevelOverlay {
+public:
+    Graph& graph;
+    std::vector<int> rank;           // Position of each node in the partition order
+    std::vector<int> byRank;         // Node at each position, so a cell's nodes are a contiguous run
+    std::vector<OverlayLevel> levels; // levels[0] has the smallest cells
+    int avoid = 0;                   // Accessibility features the cliques and queries avoid
+
+    // Partition the graph with cells of the given sizes, smallest first. Each size
+    // is rounded to a multiple of the one below so the cells nest.
+    MultiLevelOverlay(Graph& g, std::vector<int> cellSizes) : graph(g) {
+        graph.finalize();
+        bool placed = false;
+        for (int v = 0; v < graph.numNodes && !placed; ++v)
+            placed = graph.x[v] >= 0;
+        rank = placed ? hilbertOrder(graph) : bfsOrder(graph);
+        byRank.resize(graph.numNodes);
+        for (int v = 0; v < graph.numNodes; ++v)
+            byRank[rank[v]] = v;
+
+        for (size_t l = 0; l < cellSizes.size(); ++l) {
+            int size = std::max(1, cellSizes[l]);
+            if (l > 0)
+                size = std::max(1, size / levels[l - 1].cellSize) * levels[l - 1].cellSize;
+            if (size >= graph.numNodes)
+                break;
+            levels.push_back(OverlayLevel());
+            buildBoundary(levels.back(), size);
+        }
+    }
+
+    int cellOf(int level, int v) const {
+        return rank[v] / levels[level].cellSize;
+    }
+
+    // Compute every clique, bottom-up
+    void customize() {
+        for (size_t l = 0; l < levels.size(); ++l) {
+            std::vector<int> all(levels[l].cells.size());
+            for (size_t c = 0; c < all.size(); ++c)
+                all[c] = c;
+            customizeCells(l, all);
+        }
+    }
+
+    // Compute every clique for routes that avoid the given accessibility features
+    void customizeAvoiding(int features) {
+        avoid = features & (NUM_ACCESS_MASKS - 1);
+        customize();
+    }
+
+    // Re-customize after the weights of the arcs u -> v in `changed` were updated:
+    // only cells that contain such an arc are recomputed, on each level
+    void customizeChanged(const std::vector<std::pair<int, int>>& changed) {
+        for (size_t l = 0; l < levels.size(); ++l) {
+            std::vector<int> dirty;
+            for (const std::pair<int, int>& arc : changed) {
+                if (cellOf(l, arc.first) == cellOf(l, arc.second))
+                    dirty.push_back(cellOf(l, arc.first));
+            }
+            std::sort(dirty.begin(), dirty.end());
+            dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+            customizeCells(l, dirty);
+        }
+    }
+
+    // Shortest distance from src to target, INT_MAX if unreachable. path receives
+    // the route as base nodes when not null.
+    int route(int src, int target, OverlayWorkspace& ws, std::vector<int>* path = nullptr) {
+        ws.reset();
+        ws.improve(src, 0, -1, -1);
+        while (!ws.minHeap.isEmpty()) {
+            MinHeapNode top = ws.minHeap.extractMin();
+            int u = top.v;
+            if (top.f != ws.get(u))
+                continue;
+            if (u == target)
+                break;
+
+            // Highest level on which u shares a cell with neither endpoint
+            int level = -1;
+            while (level + 1 < (int)levels.size() && cellOf(level + 1, u) != cellOf(level + 1, src) &&
+                   cellOf(level + 1, u) != cellOf(level + 1, target))
+                level++;
+            if (level < 0)
+                relaxBase(u, -1, -1, ws);
+            else
+                relaxOverlay(level, u, -1, ws);
+        }
+        int distance = ws.get(target);
+        if (path && distance != INT_MAX) {
+            std::vector<int> hops, hopLevel;
+            for (int v = target; v != src; v = ws.parent[v]) {
+                hops.push_back(v);
+                hopLevel.push_back(ws.parentLevel[v]);
+            }
+            path->assign(1, src);
+            for (int i = hops.size() - 1; i >= 0; --i) {
+                if (hopLevel[i] < 0)
+                    path->push_back(hops[i]);
+                else
+                    unpack(hopLevel[i], path->back(), hops[i], ws, *path);
+            }
+        }
+        return distance;
+    }
+
+    // Bytes held by the partition and the overlay
+    long long memoryBytes() const {
+        long long bytes = (rank.size() + byRank.size()) * sizeof(int);
+        for (const OverlayLevel& level : levels) {
+            bytes += (level.entryIndex.size() + level.exitIndex.size()) * sizeof(int);
+            for (const OverlayCell& cell : level.cells)
+                bytes += (cell.entries.size() + cell.exits.size() + cell.clique.size()) * sizeof(int) + sizeof(OverlayCell);
+        }
+        return bytes;
+    }
+
+private:
+    void buildBoundary(OverlayLevel& level, int cellSize) {
+        level.cellSize = cellSize;
+        level.cells.resize((graph.numNodes + cellSize - 1) / cellSize);
+        level.entryIndex.assign(graph.numNodes, -1);
+        level.exitIndex.assign(graph.numNodes, -1);
+        for (int u = 0; u < graph.numNodes; ++u) {
+            int cell = rank[u] / cellSize;
+            for (int e = graph.firstOut[u]; e < graph.firstOut[u + 1]; ++e) {
+                int v = graph.head[e];
+                if (rank[v] / cellSize == cell)
+                    continue;
+                if (level.exitIndex[u] < 0) {
+                    level.exitIndex[u] = level.cells[cell].exits.size();
+                    level.cells[cell].exits.push_back(u);
+                }
+                OverlayCell& other = level.cells[rank[v] / cellSize];
+                if (level.entryIndex[v] < 0) {
+                    level.entryIndex[v] = other.entries.size();
+                    other.entries.push_back(v);
+                }
+            }
+        }
+    }
+
+    // Arcs of u in the base graph; cellLevel >= 0 keeps the search inside u's cell
+    // of that level
+    void relaxBase(int u, int cellLevel, int cell, OverlayWorkspace& ws) {
+        int du = ws.get(u);
+        const uint64_t* blocked = graph.blockedOut[avoid].data();
+        for (int e = graph.firstOut[u]; e < graph.firstOut[u + 1]; ++e) {
+            int v = graph.head[e];
+            if (cellLevel >= 0 && cellOf(cellLevel, v) != cell)
+                continue;
+            ws.improve(v, (du + graph.outWeight[e]) | blockedPenalty(blocked, e), u, -1);
+        }
+    }
+
+    // Arcs of boundary node u on overlay `level`: its cell's clique if u is an entry,
+    // and the arcs that cross into another cell of that level. cellLevel >= 0 keeps
+    // the search inside u's cell of that (higher) level.
+    void relaxOverlay(int level, int u, int cellLevel, OverlayWorkspace& ws) {
+        const OverlayLevel& ov = levels[level];
+        int du = ws.get(u);
+        int cell = cellOf(level, u);
+        int row = ov.entryIndex[u];
+        if (row >= 0 && !ov.cells[cell].exits.empty()) {
+            const OverlayCell& c = ov.cells[cell];
+            const int* distances = &c.clique[row * c.exits.size()];
+            for (size_t i = 0; i < c.exits.size(); ++i) {
+                if (distances[i] != INT_MAX)
+                    ws.improve(c.exits[i], du + distances[i], u, level);
+            }
+        }
+        if (ov.exitIndex[u] < 0)
+            return;
+        int outer = cellLevel >= 0 ? cellOf(cellLevel, u) : -1;
+        const uint64_t* blocked = graph.blockedOut[avoid].data();
+        for (int e = graph.firstOut[u]; e < graph.firstOut[u + 1]; ++e) {
+            int v = graph.head[e];
+            if (cellOf(level, v) == cell || (cellLevel >= 0 && cellOf(cellLevel, v) != outer))
+                continue;
+            ws.improve(v, (du + graph.outWeight[e]) | blockedPenalty(blocked, e), u, -1);
+        }
+    }
+
+    // Dijkstra from `source` inside its cell on `level`, over the base graph for
+    // level 0 and over the cliques of level-1 otherwise. Stops at `stopAt` if >= 0.
+    void searchCell(int level, int source, int stopAt, OverlayWorkspace& ws) {
+        int cell = cellOf(level, source);
+        ws.reset();
+        ws.improve(source, 0, -1, -1);
+        while (!ws.minHeap.isEmpty()) {
+            MinHeapNode top = ws.minHeap.extractMin();
+            int u = top.v;
+            if (top.f != ws.get(u))
+                continue;
+            if (u == stopAt)
+                return;
+            if (level == 0)
+                relaxBase(u, 0, cell, ws);
+            else
+                relaxOverlay(level - 1, u, level, ws);
+        }
+    }
+
+    // Recompute the cliques of the given cells, spread over the hardware threads
+    void customizeCells(int level, const std::vector<int>& cells) {
+        int threadCount = std::max(1, std::min((int)std::thread::hardware_concurrency(), (int)cells.size()));
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threadCount; ++t) {
+            pool.emplace_back([this, level, &cells, t, threadCount]() {
+                std::vector<int> localId(graph.numNodes, -1), localExit(graph.numNodes, -1);
+                for (size_t i = t; i < cells.size(); i += threadCount) {
+                    if (level == 0)
+                        customizeBaseCell(cells[i], localId);
+                    else
+                        customizeOverlayCell(level, cells[i], localId, localExit);
+                }
+            });
+        }
+        for (std::thread& worker : pool)
+            worker.join();
+    }
+
+    // Clique of a level 0 cell: Dijkstra from every entry over the cell's own nodes
+    // and arcs, copied into small local CSR arrays first
+    void customizeBaseCell(int c, std::vector<int>& localId) {
+        OverlayCell& cell = levels[0].cells[c];
+        int begin = c * levels[0].cellSize, end = std::min(begin + levels[0].cellSize, graph.numNodes);
+        int size = end - begin;
+        for (int r = begin; r < end; ++r)
+            localId[byRank[r]] = r - begin;
+        const uint64_t* blocked = graph.blockedOut[avoid].data();
+        std::vector<int> firstOut(1, 0), head, weight;
+        for (int r = begin; r < end; ++r) {
+            int u = byRank[r];
+            for (int e = graph.firstOut[u]; e < graph.firstOut[u + 1]; ++e) {
+                if (cellOf(0, graph.head[e]) != c || blockedPenalty(blocked, e))
+                    continue;
+                head.push_back(localId[graph.head[e]]);
+                weight.push_back(graph.outWeight[e]);
+            }
+            firstOut.push_back(head.size());
+        }
+
+        std::vector<int> dist(size);
+        MinHeap minHeap;
+        cell.clique.assign(cell.entries.size() * cell.exits.size(), INT_MAX);
+        for (size_t i = 0; i < cell.entries.size(); ++i) {
+            std::fill(dist.begin(), dist.end(), INT_MAX);
+            int source = localId[cell.entries[i]];
+            dist[source] = 0;
+            minHeap.insert(MinHeapNode(source, 0));
+            while (!minHeap.isEmpty()) {
+                MinHeapNode top = minHeap.extractMin();
+                int u = top.v;
+                if (top.f != dist[u])
+                    continue;
+                for (int e = firstOut[u]; e < firstOut[u + 1]; ++e) {
+                    if (dist[u] + weight[e] < dist[head[e]]) {
+                        dist[head[e]] = dist[u] + weight[e];
+                        minHeap.insert(MinHeapNode(head[e], dist[head[e]]));
+                    }
+                }
+            }
+            for (size_t j = 0; j < cell.exits.size(); ++j)
+                cell.clique[i * cell.exits.size() + j] = dist[localId[cell.exits[j]]];
+        }
+        for (int r = begin; r < end; ++r)
+            localId[byRank[r]] = -1;
+    }
+
+    // Clique of a cell on a higher level. The search runs over the entries of its
+    // subcells only: settling an entry scans its subcell's clique row, which gives
+    // the exits their labels, and each improved exit passes its label straight on
+    // over its arcs into neighbouring subcells. Exits of one subcell get consecutive
+    // local ids, so a clique row is matched against one contiguous slice of labels.
+    void customizeOverlayCell(int level, int c, std::vector<int>& localEntry, std::vector<int>& localExit) {
+        OverlayCell& cell = levels[level].cells[c];
+        const OverlayLevel& sub = levels[level - 1];
+        int perCell = levels[level].cellSize / sub.cellSize;
+        int firstSub = c * perCell, lastSub = std::min((c + 1) * perCell, (int)sub.cells.size());
+
+        std::vector<int> entrySub, exitBase(1, 0), exitNode, entryNode;
+        for (int s = firstSub; s < lastSub; ++s) {
+            for (int v : sub.cells[s].entries) {
+                localEntry[v] = entryNode.size();
+                entryNode.push_back(v);
+                entrySub.push_back(s);
+            }
+            for (int v : sub.cells[s].exits) {
+                localExit[v] = exitNode.size();
+                exitNode.push_back(v);
+            }
+            exitBase.push_back(exitNode.size());
+        }
+
+        // Arcs from each exit into another subcell of this cell
+        const uint64_t* blocked = graph.blockedOut[avoid].data();
+        std::vector<int> cutFirst(1, 0), cutHead, cutWeight;
+        for (int u : exitNode) {
+            for (int e = graph.firstOut[u]; e < graph.firstOut[u + 1]; ++e) {
+                int v = graph.head[e];
+                if (cellOf(level, v) != c || cellOf(level - 1, v) == cellOf(level - 1, u) ||
+                    blockedPenalty(blocked, e))
+                    continue;
+                cutHead.push_back(localEntry[v]);
+                cutWeight.push_back(graph.outWeight[e]);
+            }
+            cutFirst.push_back(cutHead.size());
+        }
+
+        std::vector<int> distEntry(entryNode.size()), distExit(exitNode.size());
+        MinHeap minHeap;
+        cell.clique.assign(cell.entries.size() * cell.exits.size(), INT_MAX);
+        for (size_t i = 0; i < cell.entries.size(); ++i) {
+            std::fill(distEntry.begin(), distEntry.end(), INT_MAX);
+            std::fill(distExit.begin(), distExit.end(), INT_MAX);
+            int source = localEntry[cell.entries[i]];
+            distEntry[source] = 0;
+            minHeap.insert(MinHeapNode(source, 0));
+            while (!minHeap.isEmpty()) {
+                MinHeapNode top = minHeap.extractMin();
+                int u = top.v, d = top.f;
+                if (d != distEntry[u])
+                    continue;
+                const OverlayCell& subCell = sub.cells[entrySub[u]];
+                int width = subCell.exits.size();
+                const int* row = subCell.clique.data() + sub.entryIndex[entryNode[u]] * width;
+                int base = exitBase[entrySub[u] - firstSub];
+                for (int j = 0; j < width; ++j) {
+                    if (row[j] == INT_MAX || d + row[j] >= distExit[base + j])
+                        continue;
+                    int x = base + j;
+                    distExit[x] = d + row[j];
+                    for (int e = cutFirst[x]; e < cutFirst[x + 1]; ++e) {
+                        if (distExit[x] + cutWeight[e] < distEntry[cutHead[e]]) {
+                            distEntry[cutHead[e]] = distExit[x] + cutWeight[e];
+                            minHeap.insert(MinHeapNode(cutHead[e], distEntry[cutHead[e]]));
+                        }
+                    }
+                }
+            }
+            for (size_t j = 0; j < cell.exits.size(); ++j)
+                cell.clique[i * cell.exits.size() + j] = distExit[localExit[cell.exits[j]]];
+        }
+        for (int v : entryNode)
+            localEntry[v] = -1;
+        for (int v : exitNode)
+            localExit[v] = -1;
+    }
+
+    // Append the base nodes of the clique arc u -> x on `level` (u excluded). The
+    // hops are read out of ws before recursing, so one workspace serves all depths.
+    void unpack(int level, int u, int x, OverlayWorkspace& ws, std::vector<int>& path) {
+        searchCell(level, u, x, ws);
+        std::vector<int> hops, hopLevel;
+        for (int v = x; v != u; v = ws.parent[v]) {
+            hops.push_back(v);
+            hopLevel.push_back(ws.parentLevel[v]);
+        }
+        for (int i = hops.size() - 1; i >= 0; --i) {
+            if (hopLevel[i] < 0)
+                path.push_back(hops[i]);
+            else
+                unpack(hopLevel[i], path.back(), hops[i], ws, path);
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Query log. The server and the CLI can append every route query they receive
+// to a binary file, so a production load can be replayed later with --replay.
+// Query threads only push into a lock-free ring buffer. A background thread
+// drains it to the file, so logging never blocks or slows a query. When the ring
+// is full the record is dropped and counted instead.
+// ---------------------------------------------------------------------------
+
+// One logged route query, with node numbers and fields as the client sent them
+class QueryRecord {
+public:
+    long long timestamp;   // Arrival in microseconds since the Unix epoch
+    int source, target;    // Public node numbers
+    int minute;            // Departure in minutes after midnight
+    int type, weather;
+};
+
+// On disk every record is 24 little-endian bytes:
+//   0 tag, 1 type, 2 weather, 3 unused, 4-5 minute, 6-7 unused,
+//   8-15 timestamp, 16-19 source, 20-23 target
+// The tag starts each record, so a truncated or foreign file is detected. There
+// is no file header, which lets several CLI processes append to one log.
+const int QUERY_RECORD_BYTES = 24;
+const unsigned char QUERY_RECORD_TAG = 0xB1;
+
+// Pack a record into its QUERY_RECORD_BYTES on-disk form, and back. decode
+// returns false when the bytes do not start with the record tag.
+void encodeQueryRecord(const QueryRecord& r, unsigned char* out);
+bool decodeQueryRecord(const unsigned char* in, QueryRecord& r);
+
+// Bounded multi-producer, single-consumer ring (Vyukov's queue). Each slot's
+// sequence number says whether it is free for the producer at that position or
+// full for the consumer, so neither side takes a lock.
+class QueryLogRing {
+public:
+    class Slot {
+    public:
+        std::atomic<size_t> sequence;
+        QueryRecord record;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    std::atomic<size_t> enqueuePos;
+    size_t dequeuePos;              // Only touched by the consumer
+
+    // capacity must be a power of two
+    QueryLogRing(size_t capacity) : slots(new Slot[capacity]), mask(capacity - 1), enqueuePos(0), dequeuePos(0) {
+        for (size_t i = 0; i < capacity; ++i)
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // Returns false when the ring is full
+    bool push(const QueryRecord& record) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots[pos & mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            long long diff = (long long)sequence - (long long)pos;
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.record = record;
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pop(QueryRecord& record) {
+        Slot& slot = slots[dequeuePos & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+            return false;
+        record = slot.record;
+        slot.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+        dequeuePos++;
+        return true;
+    }
+};
+
+// Appends queries to a log file from a background std::thread that wakes every
+// flushInterval, or at once on shutdown. The destructor drains the ring.
+class QueryLog {
+public:
+    QueryLog(const std::string& path, size_t capacity = 1 << 16, std::chrono::milliseconds interval = std::chrono::milliseconds(20))
+        : ring(capacity), file(path, std::ios::binary | std::ios::app), flushInterval(interval), dropped(0), stopping(false) {
+        if (file)
+            flusher = std::thread(&QueryLog::flushLoop, this);
+    }
+
+    ~QueryLog() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_one();
+        if (flusher.joinable())
+            flusher.join();
+    }
+
+    bool isOpen() const {
+        return bool(file);
+    }
+
+    // Called on the query path; never blocks
+    void record(int source, int target, int departure, int type, int weather) {
+        QueryRecord r;
+        r.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        r.source = source;
+        r.target = target;
+        r.minute = departure / 60;
+        r.type = type;
+        r.weather = weather;
+        if (!ring.push(r))
+            dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    long long droppedRecords() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    QueryLogRing ring;
+    std::ofstream file;
+    std::chrono::milliseconds flushInterval;
+    std::atomic<long long> dropped;
+    std::mutex lock;                     // Only for waking the flusher, never taken by record()
+    std::condition_variable wake;
+    bool stopping;
+    std::thread flusher;
+
+    void flushLoop() {
+        std::vector<unsigned char> buffer;
+        std::unique_lock<std::mutex> guard(lock);
+        while (true) {
+            bool last = wake.wait_for(guard, flushInterval, [this] { return stopping; });
+            guard.unlock();
+            QueryRecord r;
+            while (ring.pop(r)) {
+                buffer.resize(buffer.size() + QUERY_RECORD_BYTES);
+                encodeQueryRecord(r, &buffer[buffer.size() - QUERY_RECORD_BYTES]);
+            }
+            // One write per drain, so appends of concurrent processes do not interleave
+            if (!buffer.empty()) {
+                file.write((const char*)buffer.data(), buffer.size());
+                file.flush();
+                buffer.clear();
+            }
+            if (last)
+                return;
+            guard.lock();
+        }
+    }
+};
+
+// Reads a whole query log. Returns false with an error if the file is missing or
+// not a query log.
+bool readQueryLog(const std::string& path, std::vector<QueryRecord>& records, std::string& error);
+
+// True if the file starts like a query log rather than a text workload
+bool isQueryLog(const std::string& path);
+
+#endif
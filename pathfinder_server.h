@@ -0,0 +1,530 @@
+// Internals of the built-in HTTP/1.1 server (--serve): request and JSON parsing,
+// the field checks of the query endpoints and the query scheduler. Linux only,
+// like the server. The server tests use them directly; clients talk to the
+// server over HTTP.
+
+#ifndef PATHFINDER_SERVER_H
+#define PATHFINDER_SERVER_H
+
+#include "pathfinder.h"
+
+#ifdef __linux__
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+const size_t MAX_HEADER_BYTES = 8192;
+const size_t MAX_BODY_BYTES = 65536;
+
+class HttpRequest {
+public:
+    std::string method;
+    std::string path;
+    std::string body;
+    bool keepAlive;
+    bool http11;                    // Chunked responses are only sent to HTTP/1.1 clients
+};
+
+// Take one complete request off the front of in.
+// Returns 1 when a request was parsed, 0 when more bytes are needed and -1 for a bad request.
+int parseHttpRequest(std::string& in, HttpRequest& req);
+
+// Values of a flat JSON object such as {"start": "12", "time": 9}. Strings are
+// unescaped, numbers and literals are kept as written. Nested values are rejected.
+bool parseJsonObject(const std::string& text, std::map<std::string, std::string>& fields);
+
+std::string jsonEscape(const std::string& text);
+
+// stdout of the CLI with trailing whitespace removed, like server.js sends it
+std::string trimmed(const std::string& text);
+
+// A field as an int; throws std::invalid_argument / std::out_of_range like std::stoi
+int intField(std::map<std::string, std::string>& fields, const std::string& key);
+
+// /findpath: {start, end, type, time, weather} -> profile, node numbers and
+// departure time. Returns 1 for a valid query, 0 when no profile matches (empty
+// result, like the CLI) and -1 with an error message for invalid input.
+int parseRouteFields(const Router& router, std::map<std::string, std::string>& fields, int& profile, int& sourceNode,
+                     int& targetNode, int& departure, std::string& error);
+
+// Priority classes of route queries. Emergency queries (the "priority" field of
+// a request, for emergency personnel) go ahead of all kiosk traffic: they are
+// never batched behind a window, never shed, and interrupt a running kiosk batch
+// when no thread is free.
+enum QueryPriority { PRIORITY_EMERGENCY, PRIORITY_KIOSK, NUM_PRIORITIES };
+
+// "priority": "emergency" or "kiosk" (the default)
+bool parsePriority(std::map<std::string, std::string>& fields, int& priority);
+
+// Answer to a scheduled route query, posted back to the worker owning the connection
+class RouteCompletion {
+public:
+    int fd;
+    unsigned long long connId;      // Guards against the fd having been closed and reused meanwhile
+    std::string result;
+    bool stream;                    // One line of a progressive answer
+    bool last;                      // No more results follow for this query
+    bool shed;                      // Turned away by admission control; result is the reason
+};
+
+// Completions waiting for one worker; the worker's epoll loop watches eventFd
+class WorkerInbox {
+public:
+    int eventFd;
+    std::mutex lock;
+    std::vector<RouteCompletion> items;
+
+    WorkerInbox() : eventFd(eventfd(0, EFD_NONBLOCK)) {}
+
+    void post(RouteCompletion completion) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            items.push_back(std::move(completion));
+        }
+        uint64_t one = 1;
+        if (write(eventFd, &one, sizeof(one)) < 0) {
+            // Only fails when the counter is already pending, and then the worker wakes anyway
+        }
+    }
+};
+
+class RouteWaiter {
+public:
+    WorkerInbox* inbox;
+    int fd;
+    unsigned long long connId;
+
+    void shed() const {
+        inbox->post(RouteCompletion{fd, connId, "Server busy, try again shortly", false, true, true});
+    }
+};
+
+// Stops a progressive query. The worker raises both flags when the client
+// disconnects; the scheduler raises only stop to preempt a kiosk query, which
+// then runs again from the start.
+class StreamCancel {
+public:
+    std::atomic<bool> stop{false};
+    std::atomic<bool> disconnected{false};
+};
+
+// A progressive route query; it is never batched or coalesced, since each client
+// can cancel its own
+class StreamJob {
+public:
+    int priority, profile, avoid, source, departure, target;
+    double suboptimality;
+    RouteWaiter waiter;
+    std::shared_ptr<StreamCancel> cancel;
+    std::chrono::steady_clock::time_point queuedAt;
+    bool restarted = false;         // Preempted once already; its response is under way, so it is never shed
+    ProgressiveState progress{};    // Whether the client has the quick route, across restarts
+};
+
+// A nearest-facility query; it is answered by one search of its own
+class NearestJob {
+public:
+    int priority, profile, avoid, source, departure;
+    Facility category;
+    int k;
+    std::string name;               // Category as the client named it, for the answer text
+    RouteWaiter waiter;
+    std::chrono::steady_clock::time_point queuedAt;
+};
+
+// /nearest: {start, category, k, type, time, weather, access} -> the query of a
+// NearestJob, all but its priority and waiter. Returns 1, 0 or -1 like
+// parseRouteFields.
+int parseNearestFields(const Router& router, std::map<std::string, std::string>& fields, NearestJob& job, std::string& error);
+
+// Targets queued for one (priority, profile, avoid, source, departure) key
+class SourceBatch {
+public:
+    std::vector<int> targets;
+    std::chrono::steady_clock::time_point deadline;
+    std::chrono::steady_clock::time_point queuedAt;  // When the oldest target arrived
+};
+
+// Admission control of the scheduler. server.js uses the same defaults for its
+// engine processes; change them together.
+class AdmissionLimits {
+public:
+    size_t maxQueued = 256;                           // Queries waiting for a thread; kiosk ones beyond are shed
+    std::chrono::milliseconds queueTimeout{2000};     // Kiosk queries that waited longer are shed, not run
+    long long maxExpansions[NUM_PRIORITIES] = {0, 1000000};  // Search budget per query, 0 for no limit
+};
+
+// Query scheduler in front of the engine for the server. Identical (priority,
+// profile, source, departure, target) queries in flight at the same time share
+// one computation, and kiosk queries that share all but the target are grouped
+// for up to `window` and then answered by a single one-to-many sweep. A batch is
+// flushed when its window expires or it reaches maxBatch targets, which bounds
+// the extra latency.
+//
+// Admission: at most limits.maxQueued queries wait for a thread. A kiosk query
+// arriving at a full queue is shed with 503, and an emergency one takes the place
+// of the newest kiosk query instead. Every search runs with the expansion budget
+// of its class, so a kiosk query holds a thread for bounded time. Nearest-facility
+// queries share the queue, the limits and the priorities, but are neither
+// batched nor coalesced.
+class QueryScheduler {
+public:
+    const Router& router;
+    std::chrono::microseconds window;
+    size_t maxBatch;
+    AdmissionLimits limits;
+    std::mutex lock;
+    std::condition_variable wake;
+    std::map<std::tuple<int, int, int, int, int, int>, std::vector<RouteWaiter>> inFlight;  // (priority, profile, avoid, source, departure, target) -> waiting clients
+    std::map<std::tuple<int, int, int, int, int>, SourceBatch> batches;                // (priority, profile, avoid, source, departure) -> targets not started yet
+    std::deque<StreamJob> streams[NUM_PRIORITIES];                                     // Progressive queries, in arrival order
+    std::deque<NearestJob> nearestJobs[NUM_PRIORITIES];                                // Nearest-facility queries, in arrival order
+    size_t queued;                                                                     // Targets in batches plus stream and nearest jobs
+    int idle;                                                                          // Threads waiting for work
+    std::vector<std::atomic<bool>*> runningKiosk;                                      // Preemption flags of kiosk queries being answered
+    long long batchesAnswered;                                                         // Each by one Router::routeMany call
+    bool stopping;
+    std::vector<std::thread> threads;
+
+    QueryScheduler(const Router& r, int threadCount, std::chrono::microseconds batchWindow, size_t batchLimit,
+                   const AdmissionLimits& admission)
+        : router(r), window(batchWindow), maxBatch(batchLimit), limits(admission), queued(0), idle(threadCount),
+          batchesAnswered(0), stopping(false) {
+        for (int i = 0; i < threadCount; ++i)
+            threads.emplace_back(&QueryScheduler::run, this);
+    }
+
+    // Threads finish the query they are answering; queued ones are dropped
+    ~QueryScheduler() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : threads)
+            t.join();
+    }
+
+    // Returns false if the query was shed; the caller answers it then
+    bool submit(int priority, int profile, int avoid, int source, int departure, int target, RouteWaiter waiter) {
+        std::lock_guard<std::mutex> guard(lock);
+        auto query = std::make_tuple(priority, profile, avoid, source, departure, target);
+        auto coalesced = inFlight.find(query);
+        if (coalesced != inFlight.end()) {
+            coalesced->second.push_back(waiter);  // Shares an identical query already queued or running
+            return true;
+        }
+        if (!admit(priority))
+            return false;
+        inFlight[query].push_back(waiter);
+
+        auto now = std::chrono::steady_clock::now();
+        auto key = std::make_tuple(priority, profile, avoid, source, departure);
+        bool fresh = batches.find(key) == batches.end();
+        SourceBatch& batch = batches[key];
+        if (fresh) {
+            batch.deadline = priority == PRIORITY_EMERGENCY ? now : now + window;
+            batch.queuedAt = now;
+        }
+        batch.targets.push_back(target);
+        queued++;
+        if (fresh || batch.targets.size() >= maxBatch)
+            wake.notify_one();
+        if (priority == PRIORITY_EMERGENCY)
+            preemptKiosk();
+        return true;
+    }
+
+    bool submitStream(StreamJob job) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!admit(job.priority))
+            return false;
+        job.queuedAt = std::chrono::steady_clock::now();
+        int priority = job.priority;
+        streams[priority].push_back(std::move(job));
+        queued++;
+        wake.notify_one();
+        if (priority == PRIORITY_EMERGENCY)
+            preemptKiosk();
+        return true;
+    }
+
+    bool submitNearest(NearestJob job) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!admit(job.priority))
+            return false;
+        job.queuedAt = std::chrono::steady_clock::now();
+        int priority = job.priority;
+        nearestJobs[priority].push_back(std::move(job));
+        queued++;
+        wake.notify_one();
+        if (priority == PRIORITY_EMERGENCY)
+            preemptKiosk();
+        return true;
+    }
+
+private:
+    // Room for one more query (lock held). An emergency query is always admitted,
+    // evicting the newest queued kiosk query when the queue is full.
+    bool admit(int priority) {
+        if (queued < limits.maxQueued)
+            return true;
+        if (priority != PRIORITY_EMERGENCY)
+            return false;
+
+        std::deque<StreamJob>& kioskStreams = streams[PRIORITY_KIOSK];
+        std::deque<NearestJob>& kioskNearest = nearestJobs[PRIORITY_KIOSK];
+        auto newest = batches.end();
+        for (auto it = batches.begin(); it != batches.end(); ++it) {
+            if (std::get<0>(it->first) == PRIORITY_KIOSK && (newest == batches.end() || it->second.queuedAt > newest->second.queuedAt))
+                newest = it;
+        }
+        auto never = std::chrono::steady_clock::time_point::min();
+        auto batchTime = newest == batches.end() ? never : newest->second.queuedAt;
+        auto streamTime = kioskStreams.empty() || kioskStreams.back().restarted ? never : kioskStreams.back().queuedAt;
+        auto nearestTime = kioskNearest.empty() ? never : kioskNearest.back().queuedAt;
+        if (streamTime != never && streamTime >= batchTime && streamTime >= nearestTime) {
+            kioskStreams.back().waiter.shed();
+            kioskStreams.pop_back();
+            queued--;
+        } else if (nearestTime != never && nearestTime >= batchTime) {
+            kioskNearest.back().waiter.shed();
+            kioskNearest.pop_back();
+            queued--;
+        } else if (newest != batches.end()) {
+            int profile, avoid, source, departure;
+            std::tie(std::ignore, profile, avoid, source, departure) = newest->first;
+            shedTarget(std::make_tuple(PRIORITY_KIOSK, profile, avoid, source, departure, newest->second.targets.back()));
+            newest->second.targets.pop_back();
+            if (newest->second.targets.empty())
+                batches.erase(newest);
+            queued--;
+        }
+        return true;
+    }
+
+    // Turn away every client waiting for a query (lock held)
+    void shedTarget(const std::tuple<int, int, int, int, int, int>& query) {
+        auto it = inFlight.find(query);
+        for (const RouteWaiter& waiter : it->second)
+            waiter.shed();
+        inFlight.erase(it);
+    }
+
+    // With every thread busy, interrupt one kiosk batch or stream so a thread picks
+    // up the emergency query; the kiosk query goes back to the queue (lock held).
+    // Searches poll the flag every CANCEL_POLL_INTERVAL expansions.
+    void preemptKiosk() {
+        if (idle > 0)
+            return;
+        for (std::atomic<bool>* flag : runningKiosk) {
+            if (!flag->load(std::memory_order_relaxed)) {
+                flag->store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    // Work is taken in priority order: emergency streams, nearest queries and
+    // batches, then kiosk ones in the same order
+    void run() {
+        std::unique_lock<std::mutex> guard(lock);
+        while (!stopping) {
+            auto now = std::chrono::steady_clock::now();
+            auto due = batches.end();
+            auto next = std::chrono::steady_clock::time_point::max();
+            for (auto it = batches.begin(); it != batches.end(); ++it) {
+                if (it->second.deadline <= now || it->second.targets.size() >= maxBatch) {
+                    due = it;  // Keys start with the priority, so the first due batch is the most urgent
+                    break;
+                }
+                next = std::min(next, it->second.deadline);
+            }
+            int batchPriority = due == batches.end() ? NUM_PRIORITIES : std::get<0>(due->first);
+            int streamPriority = 0;
+            while (streamPriority < NUM_PRIORITIES && streams[streamPriority].empty())
+                streamPriority++;
+            int nearestPriority = 0;
+            while (nearestPriority < NUM_PRIORITIES && nearestJobs[nearestPriority].empty())
+                nearestPriority++;
+
+            if (streamPriority < NUM_PRIORITIES && streamPriority <= batchPriority) {
+                StreamJob job = std::move(streams[streamPriority].front());
+                streams[streamPriority].pop_front();
+                queued--;
+                if (job.priority == PRIORITY_KIOSK && !job.restarted && now - job.queuedAt > limits.queueTimeout) {
+                    job.waiter.shed();
+                    continue;
+                }
+                std::atomic<bool>* stop = &job.cancel->stop;
+                if (job.priority == PRIORITY_KIOSK)
+                    runningKiosk.push_back(stop);
+                idle--;
+                guard.unlock();
+                bool answered = answerStream(job);
+                guard.lock();
+                idle++;
+                if (job.priority == PRIORITY_KIOSK)
+                    runningKiosk.erase(std::find(runningKiosk.begin(), runningKiosk.end(), stop));
+                if (!answered && !job.cancel->disconnected.load(std::memory_order_relaxed)) {
+                    // Preempted: first in line among the kiosk streams. It resumes
+                    // with the optimal search if the client has the early route.
+                    job.cancel->stop.store(false, std::memory_order_relaxed);
+                    job.restarted = true;
+                    streams[PRIORITY_KIOSK].push_front(std::move(job));
+                    queued++;
+                }
+                continue;
+            }
+            if (nearestPriority < NUM_PRIORITIES && nearestPriority <= batchPriority) {
+                NearestJob job = std::move(nearestJobs[nearestPriority].front());
+                nearestJobs[nearestPriority].pop_front();
+                queued--;
+                if (job.priority == PRIORITY_KIOSK && now - job.queuedAt > limits.queueTimeout) {
+                    job.waiter.shed();
+                    continue;
+                }
+                std::atomic<bool> preempted(false);
+                if (job.priority == PRIORITY_KIOSK)
+                    runningKiosk.push_back(&preempted);
+                idle--;
+                guard.unlock();
+                std::string result;
+                bool answered = answerNearest(job, &preempted, result);
+                if (answered)
+                    job.waiter.inbox->post(RouteCompletion{job.waiter.fd, job.waiter.connId, result, false, true, false});
+                guard.lock();
+                idle++;
+                if (job.priority == PRIORITY_KIOSK)
+                    runningKiosk.erase(std::find(runningKiosk.begin(), runningKiosk.end(), &preempted));
+                if (!answered) {
+                    // Preempted: first in line among the kiosk nearest queries
+                    nearestJobs[PRIORITY_KIOSK].push_front(std::move(job));
+                    queued++;
+                }
+                continue;
+            }
+            if (due == batches.end()) {
+                if (batches.empty())
+                    wake.wait(guard);
+                else
+                    wake.wait_until(guard, next);
+                continue;
+            }
+
+            auto key = due->first;
+            int priority, profile, avoid, source, departure;
+            std::tie(priority, profile, avoid, source, departure) = key;
+            SourceBatch batch = std::move(due->second);
+            batches.erase(due);
+            queued -= batch.targets.size();
+            if (priority == PRIORITY_KIOSK && now - batch.queuedAt > limits.queueTimeout) {
+                for (int target : batch.targets)
+                    shedTarget(std::make_tuple(priority, profile, avoid, source, departure, target));
+                continue;
+            }
+
+            std::atomic<bool> preempted(false);
+            if (priority == PRIORITY_KIOSK)
+                runningKiosk.push_back(&preempted);
+            idle--;
+            guard.unlock();
+            std::vector<std::string> results;
+            bool answered = answerBatch(priority, profile, avoid, source, departure, batch.targets, &preempted, results);
+            guard.lock();
+            idle++;
+            if (priority == PRIORITY_KIOSK)
+                runningKiosk.erase(std::find(runningKiosk.begin(), runningKiosk.end(), &preempted));
+
+            if (!answered) {
+                // Preempted: back to the queue, due at once but behind the emergency work
+                SourceBatch& again = batches[key];
+                again.targets.insert(again.targets.begin(), batch.targets.begin(), batch.targets.end());
+                again.deadline = now;
+                again.queuedAt = batch.queuedAt;
+                queued += batch.targets.size();
+                continue;
+            }
+            batchesAnswered++;
+            std::vector<std::pair<RouteWaiter, std::string>> deliveries;
+            for (size_t i = 0; i < batch.targets.size(); ++i) {
+                auto it = inFlight.find(std::make_tuple(priority, profile, avoid, source, departure, batch.targets[i]));
+                for (RouteWaiter& waiter : it->second)
+                    deliveries.push_back(std::make_pair(waiter, results[i]));
+                inFlight.erase(it);
+            }
+            guard.unlock();
+            for (auto& d : deliveries)
+                d.first.inbox->post(RouteCompletion{d.first.fd, d.first.connId, d.second, false, true, false});
+            guard.lock();
+        }
+    }
+
+    // Each result goes back to the worker as soon as it is found. Returns false if
+    // the query was stopped by a disconnect or a preemption.
+    bool answerStream(StreamJob& job) {
+        if (job.cancel->disconnected.load(std::memory_order_relaxed))
+            return false;
+        QueryLimits query;
+        query.avoid = job.avoid;
+        query.maxExpansions = limits.maxExpansions[job.priority];
+        query.cancel = &job.cancel->stop;
+        std::string text;
+        return router.routeProgressive(job.source, job.target, job.profile, job.departure, job.suboptimality,
+            [&](const RouteResult& route) {
+                formatRoute(route, text);
+                job.waiter.inbox->post(RouteCompletion{job.waiter.fd, job.waiter.connId, trimmed(text), true,
+                                                       route.optimal || route.exhausted, false});
+            }, query, &job.progress);
+    }
+
+    // Returns false if the query was preempted before it finished
+    bool answerNearest(const NearestJob& job, const std::atomic<bool>* preempted, std::string& result) {
+        QueryLimits query;
+        query.avoid = job.avoid;
+        query.maxExpansions = limits.maxExpansions[job.priority];
+        query.cancel = preempted;
+        std::vector<FacilityResult> matches;
+        bool exhausted;
+        if (!router.nearest(job.source, job.category, job.k, job.profile, job.departure, matches, query, &exhausted))
+            return false;
+        formatNearest(matches, job.name, result, exhausted);
+        result = trimmed(result);
+        return true;
+    }
+
+    // Router::routeMany picks A* or one sweep from the shared source. Returns false
+    // if the batch was preempted before it finished.
+    bool answerBatch(int priority, int profile, int avoid, int source, int departure, const std::vector<int>& targets,
+                     const std::atomic<bool>* preempted, std::vector<std::string>& results) {
+        QueryLimits query;
+        query.avoid = avoid;
+        query.maxExpansions = limits.maxExpansions[priority];
+        query.cancel = preempted;
+        std::vector<RouteResult> routes;
+        if (!router.routeMany(source, targets, profile, departure, routes, query))
+            return false;
+        results.resize(targets.size());
+        std::string text;
+        for (size_t i = 0; i < targets.size(); ++i) {
+            formatRoute(routes[i], text);
+            results[i] = trimmed(text);
+        }
+        return true;
+    }
+};
+#endif
+
+#endif
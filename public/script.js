@@ -1,42 +1,107 @@
-function findPath() {
-    const start = document.getElementById('start').value;
-    const end = document.getElementById('end').value;
-    const type =document.getElementById('transport').value;
-    const time = new Date().getHours();
-    const weather=document.getElementById('weather_type').value;
-    
-    if (!start || !end ) {
-        alert('Please enter both start and end nodes.');
-        return;
-    }
-    if(!type){
-        alert('Please pick type of way you want to travel');
-        return;
-    }
-    if(!weather){
-        alert('Weather field not field');
-    }
-
-    document.getElementById('result').textContent = 'Calculating...';
-
-    fetch('/findpath', {
-        method: 'POST',
-        headers: {
-            'Content-Type': 'application/json',
-        },
-        body: JSON.stringify({ start, end, type, time, weather }),
-    })
-    .then(response => response.json())
-    .then(data => {
-        if (data.error) {
-            document.getElementById('result').textContent = `Error: ${data.error}`;
-        } else {
-            document.getElementById('result').textContent = data.result;
-        }
-    })
-    
-    .catch(error => {
-        console.error('Error:', error);
-        document.getElementById('result').textContent = 'An error occurred while communicating with the server.';
-    });
+function findPath() {
+    const start = document.getElementById('start').value;
+    const end = document.getElementById('end').value;
+    const type =document.getElementById('transport').value;
+    const now = new Date();
+    const time = now.getHours() + ':' + String(now.getMinutes()).padStart(2, '0');
+    const weather=document.getElementById('weather_type').value;
+    const access = document.getElementById('access').value === '1' ? 'wheelchair' : 'any';
+    
+    if (!start || !end ) {
+        alert('Please enter both start and end nodes.');
+        return;
+    }
+    if(!type){
+        alert('Please pick type of way you want to travel');
+        return;
+    }
+    if(!weather){
+        alert('Weather field not field');
+    }
+
+    document.getElementById('result').textContent = 'Calculating...';
+
+    // A newer query replaces the one still running; aborting the request makes the
+    // server stop searching for it
+    if (pendingQuery) {
+        pendingQuery.abort();
+    }
+    const query = new AbortController();
+    pendingQuery = query;
+
+    // /findpath/stream answers with one JSON object per line: a quick route that is
+    // shown while the optimal one is being computed, then the optimal route
+    fetch('/findpath/stream', {
+        method: 'POST',
+        headers: {
+            'Content-Type': 'application/json',
+        },
+        body: JSON.stringify({ start, end, type, time, weather, access }),
+        signal: query.signal,
+    })
+    .then(response => {
+        if (!response.body) {
+            return response.text().then(text => showRouteLines(text));
+        }
+        const reader = response.body.getReader();
+        const decoder = new TextDecoder();
+        let buffered = '';
+        const readMore = () => reader.read().then(({ done, value }) => {
+            buffered += decoder.decode(value || new Uint8Array(), { stream: !done });
+            const lineEnd = buffered.lastIndexOf('\n');
+            if (lineEnd >= 0) {
+                showRouteLines(buffered.slice(0, lineEnd));
+                buffered = buffered.slice(lineEnd + 1);
+            }
+            if (done) {
+                showRouteLines(buffered);
+                return;
+            }
+            return readMore();
+        });
+        return readMore();
+    })
+    .catch(error => {
+        if (error.name === 'AbortError') {
+            return;
+        }
+        console.error('Error:', error);
+        document.getElementById('result').textContent = 'An error occurred while communicating with the server.';
+    })
+    .finally(() => {
+        if (pendingQuery === query) {
+            pendingQuery = null;
+        }
+    });
+}
+
+let pendingQuery = null;
+
+// Show the last complete answer among the NDJSON lines received
+function showRouteLines(text) {
+    const lines = text.split('\n').filter(line => line.trim());
+    if (lines.length === 0) {
+        return;
+    }
+    const data = JSON.parse(lines[lines.length - 1]);
+    if (data.error) {
+        document.getElementById('result').textContent = `Error: ${data.error}`;
+    } else if (data.optimal === false) {
+        document.getElementById('result').textContent = `${data.result}\n(refining...)`;
+    } else {
+        document.getElementById('result').textContent = data.result;
+    }
+}
+
+// Map clicks fill the start field, then the end field, alternately.
+// The pixel position on map.jpg is sent as "x,y" and snapped to the nearest road by the engine.
+let pickEnd = false;
+
+function pickPoint(event) {
+    const map = event.target;
+    const x = Math.round(event.offsetX * map.naturalWidth / map.clientWidth);
+    const y = Math.round(event.offsetY * map.naturalHeight / map.clientHeight);
+
+    document.getElementById(pickEnd ? 'end' : 'start').value = `${x},${y}`;
+    pickEnd = !pickEnd;
 }
\ No newline at end of file
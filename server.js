@@ -1,30 +1,194 @@
-const express = require('express');
-const { exec } = require('child_process');
-const path = require('path');
-
-const app = express();
-const port = 3001;  // Changed to 3001
-
-app.use(express.static('public'));
-app.use(express.json());
-
-app.post('/findpath', (req, res) => {
-    const { start, end, type, time, weather } = req.body;
-    const pathfinderExecutable = path.join(__dirname, process.platform === 'win32' ? 'pathfinder.exe' : 'pathfinder');
-
-    exec(`${pathfinderExecutable} ${start} ${end} ${type} ${time} ${weather}`, (error, stdout, stderr) => {
-        if (error) {
-            console.error(`Error: ${error.message}`);
-            return res.status(500).json({ error: 'Internal Server Error' });
-        }
-        if (stderr) {
-            console.error(`stderr: ${stderr}`);
-            return res.status(500).json({ error: 'Internal Server Error' });
-        }
-        res.json({ result: stdout.trim() });
-    });
-});
-
-app.listen(port, () => {
-    console.log(`Server running at http://localhost:${port}`);
+const express = require('express');
+const { execFile } = require('child_process');
+const os = require('os');
+const path = require('path');
+
+const app = express();
+const port = 3001;  // Changed to 3001
+// Built by CMake into build/<preset>/; PATHFINDER_BIN points at the one to use
+const pathfinderExecutable = process.env.PATHFINDER_BIN ||
+    path.join(__dirname, 'build', 'release', process.platform === 'win32' ? 'pathfinder.exe' : 'pathfinder');
+// Route queries are appended to this binary log when set (see --replay)
+const queryLogOption = process.env.PATHFINDER_QUERY_LOG ? ['--query-log', process.env.PATHFINDER_QUERY_LOG] : [];
+
+// Admission control. At most MAX_ENGINE_PROCESSES engine processes run at once;
+// other queries wait in a queue per priority class ("priority": "emergency" or
+// "kiosk"). Emergency queries start first, take the place of the newest kiosk
+// query when the queues are full, and stop the newest running kiosk query when
+// every process slot is taken; that query goes back to the front of its queue.
+// Kiosk queries get 503 when the queues are full or after waiting
+// QUEUE_TIMEOUT_MS. They search with an expansion budget, and any process still
+// running after ENGINE_TIMEOUT_MS is killed.
+//
+// MAX_QUEUED, QUEUE_TIMEOUT_MS and KIOSK_MAX_EXPANSIONS are the defaults of
+// AdmissionLimits in pathfinder.cpp, so both servers turn away the same load;
+// change them together. ENGINE_TIMEOUT_MS has no counterpart there: a thread
+// cannot be killed, so the built-in server relies on the expansion budget alone.
+const MAX_ENGINE_PROCESSES = os.cpus().length;
+const MAX_QUEUED = 256;
+const QUEUE_TIMEOUT_MS = 2000;
+const ENGINE_TIMEOUT_MS = 5000;
+const KIOSK_MAX_EXPANSIONS = 1000000;
+
+const queues = { emergency: [], kiosk: [] };
+const running = [];
+
+// Engine option for the request's "access" field
+function accessOption(req) {
+    return req.body.access === 'wheelchair' ? ['--access', 'wheelchair'] : [];
+}
+
+// Request fields are passed to the engine as separate arguments, never through a
+// shell, and are checked first so the engine only sees well-formed values
+const NODE_PATTERN = /^\d+(,\d+)?$/;          // Node number or map position "x,y"
+const INTEGER_PATTERN = /^\d+$/;
+const TIME_PATTERN = /^\d{1,2}(:\d{2})?$/;    // "H" or "H:MM"
+const CATEGORIES = ['washroom', 'exit', 'medical', 'food'];
+
+// The engine arguments for a route query, or null if a field is invalid
+function routeArguments(req) {
+    const { start, end, type, time, weather } = req.body;
+    if (![start, end].every(node => NODE_PATTERN.test(String(node))) ||
+        ![type, weather].every(value => INTEGER_PATTERN.test(String(value))) || !TIME_PATTERN.test(String(time))) {
+        return null;
+    }
+    return [...queryLogOption, ...accessOption(req), String(start), String(end), String(type), String(time), String(weather)];
+}
+
+function nearestArguments(req) {
+    const { start, category, type, time, weather } = req.body;
+    const k = req.body.k === undefined || req.body.k === '' ? '1' : String(req.body.k);
+    if (!NODE_PATTERN.test(String(start)) || !CATEGORIES.includes(category) || !INTEGER_PATTERN.test(k) ||
+        ![type, weather].every(value => INTEGER_PATTERN.test(String(value))) || !TIME_PATTERN.test(String(time))) {
+        return null;
+    }
+    return [...accessOption(req), '--nearest', String(start), category, k, String(type), String(time), String(weather)];
+}
+
+function rejectInvalid(res) {
+    res.status(400).json({ error: 'Invalid query' });
+}
+
+function shed(job) {
+    job.res.status(503).json({ error: 'Server busy, try again shortly' });
+}
+
+// Queue the engine argument array `args`; onDone(error, stdout, stderr) runs when it exits
+function runEngine(req, res, args, onDone) {
+    const priority = req.body.priority === 'emergency' ? 'emergency' : 'kiosk';
+    const job = { priority, res, args, onDone, queuedAt: Date.now(), child: null, preempted: false };
+    if (queues.emergency.length + queues.kiosk.length >= MAX_QUEUED) {
+        if (priority === 'kiosk') {
+            return shed(job);
+        }
+        if (queues.kiosk.length > 0) {
+            shed(queues.kiosk.pop());
+        }
+    }
+    queues[priority].push(job);
+    res.on('close', () => {
+        if (job.child && !res.writableEnded) {
+            job.child.kill();
+        }
+    });
+    if (priority === 'emergency' && running.length >= MAX_ENGINE_PROCESSES) {
+        const victim = running.filter(other => other.priority === 'kiosk' && !other.preempted).pop();
+        if (victim) {
+            victim.preempted = true;
+            victim.child.kill();
+        }
+    }
+    startQueued();
+}
+
+function startQueued() {
+    while (running.length < MAX_ENGINE_PROCESSES) {
+        const job = queues.emergency.shift() || queues.kiosk.shift();
+        if (!job) {
+            return;
+        }
+        if (job.res.destroyed) {
+            continue;
+        }
+        if (job.priority === 'kiosk' && Date.now() - job.queuedAt > QUEUE_TIMEOUT_MS) {
+            shed(job);
+            continue;
+        }
+        const budget = job.priority === 'kiosk' ? ['--max-expansions', String(KIOSK_MAX_EXPANSIONS)] : [];
+        running.push(job);
+        job.child = execFile(pathfinderExecutable, [...budget, ...job.args], { timeout: ENGINE_TIMEOUT_MS }, (error, stdout, stderr) => {
+            running.splice(running.indexOf(job), 1);
+            if (job.preempted) {
+                job.preempted = false;
+                job.child = null;
+                queues.kiosk.unshift(job);
+            } else if (!job.res.destroyed) {
+                job.onDone(error, stdout, stderr);
+            }
+            startQueued();
+        });
+    }
+}
+
+app.use(express.static('public'));
+app.use(express.json());
+
+app.post('/findpath', (req, res) => {
+    const args = routeArguments(req);
+    if (!args) {
+        return rejectInvalid(res);
+    }
+
+    runEngine(req, res, args, (error, stdout, stderr) => {
+        if (error) {
+            console.error(`Error: ${error.message}`);
+            return res.status(500).json({ error: 'Internal Server Error' });
+        }
+        if (stderr) {
+            console.error(`stderr: ${stderr}`);
+            return res.status(500).json({ error: 'Internal Server Error' });
+        }
+        res.json({ result: stdout.trim() });
+    });
+});
+
+// The engine process answers with the optimal route only, sent as the single line
+// of the stream; runEngine kills it when the client goes away
+app.post('/findpath/stream', (req, res) => {
+    const args = routeArguments(req);
+    if (!args) {
+        return rejectInvalid(res);
+    }
+
+    runEngine(req, res, args, (error, stdout, stderr) => {
+        res.type('application/x-ndjson');
+        if (error || stderr) {
+            console.error(`Error: ${error ? error.message : stderr}`);
+            return res.status(500).send(JSON.stringify({ error: 'Internal Server Error' }) + '\n');
+        }
+        res.send(JSON.stringify({ result: stdout.trim(), optimal: true }) + '\n');
+    });
+});
+
+app.post('/nearest', (req, res) => {
+    const args = nearestArguments(req);
+    if (!args) {
+        return rejectInvalid(res);
+    }
+
+    runEngine(req, res, args, (error, stdout, stderr) => {
+        if (error) {
+            console.error(`Error: ${error.message}`);
+            return res.status(500).json({ error: 'Internal Server Error' });
+        }
+        if (stderr) {
+            console.error(`stderr: ${stderr}`);
+            return res.status(500).json({ error: 'Internal Server Error' });
+        }
+        res.json({ result: stdout.trim() });
+    });
+});
+
+app.listen(port, () => {
+    console.log(`Server running at http://localhost:${port}`);
 });
\ No newline at end of file
@@ -0,0 +1,111 @@
+// Checks of directed and asymmetric arcs in every search: a route and its reverse
+// must each pay the weights of their own direction. In the graph below 0 -> 1 is
+// downhill (10) and 1 -> 0 uphill (100), so the way back goes round by 2 (60);
+// 1 -> 3 is one-way, so 3 cannot get back to 1 or 0.
+//
+//     0 --10/100-- 1 --5--> 3 --5-- 4
+//      \          /
+//       30      30
+//         \    /
+//           2
+
+#include "pathfinder_internal.h"
+#include "test_util.h"
+
+#include <climits>
+#include <string>
+#include <vector>
+
+const int NODES = 5;
+
+// Expected distances: [from][to]
+const int U = INT_MAX;
+const int EXPECTED[NODES][NODES] = {
+    {0, 10, 30, 15, 20},
+    {60, 0, 30, 5, 10},
+    {30, 30, 0, 35, 40},
+    {U, U, U, 0, 5},
+    {U, U, U, 5, 0},
+};
+
+static Graph buildGraph() {
+    Graph graph(NODES);
+    graph.addEdge(0, 1, 10, 100);
+    graph.addEdge(0, 2, 30);
+    graph.addEdge(2, 1, 30);
+    graph.addArc(1, 3, 5);
+    graph.addEdge(3, 4, 5);
+    return graph;
+}
+
+static std::string pair(int s, int t) {
+    return std::to_string(s) + " -> " + std::to_string(t);
+}
+
+// Walk the parent tree from t back to s, paying each arc in its own direction
+static long long pathCost(const Graph& graph, const std::vector<int>& parent, int s, int t) {
+    long long cost = 0;
+    for (int v = t; v != s; v = parent[v]) {
+        if (parent[v] < 0)
+            return -1;
+        cost += graph.arcCost(parent[v], v);
+    }
+    return cost;
+}
+
+static void checkAStar(Graph& graph, const std::string& label) {
+    std::vector<int> parent;
+    for (int s = 0; s < NODES; ++s) {
+        for (int t = 0; t < NODES; ++t) {
+            int d = aStarSearch(graph, s, t, parent, 9 * 3600);
+            check(d == EXPECTED[s][t], label + " " + pair(s, t) + ": " + std::to_string(d));
+            if (d != INT_MAX)
+                check(pathCost(graph, parent, s, t) == d, label + " " + pair(s, t) + ": path does not cost its distance");
+        }
+    }
+}
+
+static void checkMatrix(Graph& graph, int avoid, const std::string& label) {
+    std::vector<int> nodes;
+    for (int v = 0; v < NODES; ++v)
+        nodes.push_back(v);
+    std::vector<std::vector<int>> dist = distanceMatrix(graph, nodes, 9 * 3600, avoid);
+    for (int s = 0; s < NODES; ++s) {
+        for (int t = 0; t < NODES; ++t)
+            check(dist[s][t] == EXPECTED[s][t], label + " " + pair(s, t) + ": " + std::to_string(dist[s][t]));
+    }
+}
+
+int main() {
+    Graph graph = buildGraph();
+    graph.finalize();
+    check(graph.arcCost(0, 1) == 10 && graph.arcCost(1, 0) == 100, "arc costs per direction");
+    check(graph.arcCost(3, 1) == INT_MAX, "one-way arc has a reverse");
+
+    checkAStar(graph, "A*");
+    checkMatrix(graph, 0, "bulk matrix");
+    checkMatrix(graph, ACCESS_STAIRS, "one-to-many matrix");
+
+    // Turn-aware search; no turn rules, so only the U-turn ban applies, and no
+    // route here needs to turn back
+    Graph turns = buildGraph();
+    turns.enableTurns(0);
+    for (int s = 0; s < NODES; ++s) {
+        for (int t = 0; t < NODES; ++t) {
+            std::vector<int> parentArc;
+            int lastArc;
+            int d = turnAwareSearch(turns, s, t, 9 * 3600, parentArc, lastArc);
+            check(d == EXPECTED[s][t], "turn-aware " + pair(s, t) + ": " + std::to_string(d));
+        }
+    }
+
+    // Time-dependent search, with a profile that costs 100% all day on the flat
+    // edge so the distances stay the same
+    Graph timed = buildGraph();
+    int flat = timed.addTravelProfile({{0, 100}});
+    check(flat > 0 && timed.setArcProfile(0, 2, flat) && timed.setArcProfile(2, 0, flat), "flat profile");
+    check(timed.timeDependent(), "graph with a profile is not time-dependent");
+    checkAStar(timed, "time-dependent A*");
+    checkMatrix(timed, 0, "time-dependent matrix");
+    return testResult();
+}
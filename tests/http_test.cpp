@@ -0,0 +1,118 @@
+// Checks of the request parsing of the built-in server: parseHttpRequest must take
+// exactly one request off the connection buffer, wait for a partial one, apply
+// the HTTP/1.0 and 1.1 keep-alive rules and reject malformed or oversized
+// requests; parseJsonObject must read the flat bodies the kiosks send and reject
+// anything else; parseRouteFields must turn them into a query or an error.
+// The server is Linux only, so elsewhere the test is reported as skipped.
+
+#include "pathfinder_internal.h"
+#include "pathfinder_server.h"
+#include "test_util.h"
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+
+#ifdef __linux__
+static void checkHttp() {
+    HttpRequest req;
+
+    // Two pipelined requests, the first with a body and a query string
+    std::string in = "POST /findpath?x=1 HTTP/1.1\r\nHost: kiosk\r\nContent-Length: 7\r\n\r\n{\"a\":1}"
+                     "GET /index.html HTTP/1.1\r\nConnection: close\r\n\r\n";
+    check(parseHttpRequest(in, req) == 1, "first pipelined request not parsed");
+    check(req.method == "POST" && req.path == "/findpath" && req.body == "{\"a\":1}", "first request: " +
+          req.method + " " + req.path + " " + req.body);
+    check(req.http11 && req.keepAlive, "HTTP/1.1 request not kept alive");
+    check(parseHttpRequest(in, req) == 1, "second pipelined request not parsed");
+    check(req.method == "GET" && req.path == "/index.html" && req.body.empty(), "second request: " + req.method +
+          " " + req.path);
+    check(!req.keepAlive, "Connection: close ignored");
+    check(in.empty() && parseHttpRequest(in, req) == 0, "bytes left after both requests");
+
+    // A request arriving in pieces waits until its body is complete
+    std::string whole = "POST /nearest HTTP/1.1\r\nContent-Length: 5\r\n\r\nhello";
+    in = whole.substr(0, 20);
+    check(parseHttpRequest(in, req) == 0 && in.size() == 20, "partial header parsed");
+    in = whole.substr(0, whole.size() - 2);
+    check(parseHttpRequest(in, req) == 0, "partial body parsed");
+    in = whole;
+    check(parseHttpRequest(in, req) == 1 && req.body == "hello" && in.empty(), "completed request not parsed");
+
+    // HTTP/1.0 closes unless asked not to; header names and values are not case-sensitive
+    in = "GET / HTTP/1.0\r\n\r\n";
+    check(parseHttpRequest(in, req) == 1 && !req.http11 && !req.keepAlive, "HTTP/1.0 request kept alive");
+    in = "GET / HTTP/1.0\r\nCONNECTION: Keep-Alive\r\n\r\n";
+    check(parseHttpRequest(in, req) == 1 && req.keepAlive, "HTTP/1.0 keep-alive ignored");
+
+    // Bad requests
+    in = "GARBAGE\r\n\r\n";
+    check(parseHttpRequest(in, req) == -1, "request line without a path accepted");
+    in = "POST /findpath HTTP/1.1\r\nContent-Length: lots\r\n\r\n";
+    check(parseHttpRequest(in, req) == -1, "bad Content-Length accepted");
+    in = "POST /findpath HTTP/1.1\r\nContent-Length: " + std::to_string(MAX_BODY_BYTES + 1) + "\r\n\r\n";
+    check(parseHttpRequest(in, req) == -1, "oversized body accepted");
+    in = "GET / HTTP/1.1\r\nX-Padding: " + std::string(MAX_HEADER_BYTES, 'x');
+    check(parseHttpRequest(in, req) == -1, "endless header accepted");
+}
+
+static void checkJson() {
+    std::map<std::string, std::string> fields;
+    check(parseJsonObject(" { \"start\" : \"12\", \"end\":\"300,200\",\"type\": 1 ,\"time\":\"9:30\", \"weather\":0 } ",
+                          fields), "kiosk body rejected");
+    check(fields["start"] == "12" && fields["end"] == "300,200" && fields["type"] == "1" &&
+          fields["time"] == "9:30" && fields["weather"] == "0", "kiosk body fields changed");
+
+    fields.clear();
+    check(parseJsonObject("{\"a\": \"x\\\"y\\\\z\\n\", \"b\": true}", fields) && fields["a"] == "x\"y\\z\n" &&
+          fields["b"] == "true", "escapes and literals");
+    check(parseJsonObject("{\"a\": \"" + jsonEscape("line\r\n\t\"quoted\"") + "\"}", fields) &&
+          fields["a"] == "line\r\n\t\"quoted\"", "jsonEscape does not round trip");
+    fields.clear();
+    check(parseJsonObject("{}", fields) && fields.empty(), "empty object rejected");
+
+    const char* bad[] = {"", "[1, 2]", "{\"a\": 1", "{\"a\" 1}", "{\"a\": {\"b\": 1}}", "{\"a\": [1]}",
+                         "{\"a\": }", "{a: 1}", "{\"a\": \"open}"};
+    for (const char* text : bad) {
+        std::map<std::string, std::string> ignored;
+        check(!parseJsonObject(text, ignored), std::string("accepted ") + text);
+    }
+}
+
+static void checkRouteFields() {
+    std::shared_ptr<const Router> router = Router::load(RouterOptions());
+    std::map<std::string, std::string> fields;
+    parseJsonObject("{\"start\": \"0\", \"end\": \"139\", \"type\": 1, \"time\": \"9:30\", \"weather\": 0}", fields);
+    int profile, source, target, departure;
+    std::string error;
+    check(parseRouteFields(*router, fields, profile, source, target, departure, error) == 1, "valid query: " + error);
+    check(profile == campusProfile(1, 0) && source == router->resolveNode("0", profile) &&
+          target == router->resolveNode("139", profile) && departure == 9 * 3600 + 30 * 60, "valid query fields");
+
+    const char* bad[][2] = {{"time", "25:00"}, {"start", "-4"}, {"end", "banana"}, {"type", "car"}};
+    for (auto& change : bad) {
+        std::map<std::string, std::string> changed = fields;
+        changed[change[0]] = change[1];
+        error.clear();
+        check(parseRouteFields(*router, changed, profile, source, target, departure, error) == -1 && !error.empty(),
+              std::string(change[0]) + " = " + change[1] + " accepted");
+    }
+    std::map<std::string, std::string> missing = fields;
+    missing.erase("weather");
+    check(parseRouteFields(*router, missing, profile, source, target, departure, error) == -1,
+          "query without weather accepted");
+}
+
+int main() {
+    checkHttp();
+    checkJson();
+    checkRouteFields();
+    return testResult();
+}
+#else
+int main() {
+    std::cout << "The built-in server needs Linux, skipped" << std::endl;
+    return 77;
+}
+#endif
@@ -0,0 +1,54 @@
+// Checks of distanceMatrix (pathfinder_internal.h), the search behind --matrix:
+// on the walking profiles, at 08:00 before the dry-season edges 1-2 and 1-46 open
+// and at 12:00 after, with and without stairs, every entry must equal the
+// distance Router::route gives for the same pair.
+
+#include "pathfinder_internal.h"
+#include "test_util.h"
+
+#include <climits>
+#include <memory>
+#include <string>
+#include <vector>
+
+int main() {
+    std::shared_ptr<const Router> router = Router::load(RouterOptions());
+    std::vector<int> nodes = {0, 1, 2, 14, 21, 46, 139};
+    for (int v = 3; v < CAMPUS_NODES; v += 11)
+        nodes.push_back(v);
+
+    for (int profile : {PROFILE_WALK_RAIN, PROFILE_WALK_DRY}) {
+        Graph graph(CAMPUS_NODES);
+        loadCampusGraph(graph, profile, "none");
+        std::vector<int> internal;
+        for (int node : nodes)
+            internal.push_back(graph.intId[node]);
+        for (int hour : {8, 12}) {
+            for (int avoid : {0, (int)ACCESS_STAIRS}) {
+                std::vector<std::vector<int>> dist = distanceMatrix(graph, internal, hour * 3600, avoid);
+                QueryLimits limits;
+                limits.avoid = avoid;
+                int wrong = 0;
+                RouteResult route;
+                for (size_t i = 0; i < nodes.size(); ++i) {
+                    for (size_t j = 0; j < nodes.size(); ++j) {
+                        router->route(nodes[i], nodes[j], profile, hour * 3600, route, limits);
+                        if (dist[i][internal[j]] != (route.found ? route.distance : INT_MAX))
+                            wrong++;
+                    }
+                }
+                check(wrong == 0, "profile " + std::to_string(profile) + " at " + std::to_string(hour) +
+                      ":00, avoid " + std::to_string(avoid) + ": " + std::to_string(wrong) + " entries differ");
+            }
+        }
+    }
+
+    // The closure before 11:00 has to show in the table
+    Graph dry(CAMPUS_NODES);
+    loadCampusGraph(dry, PROFILE_WALK_DRY, "none");
+    std::vector<int> pair = {dry.intId[1], dry.intId[2]};
+    check(distanceMatrix(dry, pair, 8 * 3600, 0)[0][pair[1]] > distanceMatrix(dry, pair, 12 * 3600, 0)[0][pair[1]],
+          "1 -> 2 takes longer before the edge opens");
+
+    return testResult();
+}
@@ -0,0 +1,105 @@
+// Checks of Router::nearest on every campus profile. The FacilityIndex tables
+// answer k = 1 directly on the static profile and steer the searches on the
+// time-dependent and turn-modelled ones, so on all of them, from every node, at
+// 08:00 and 12:00, with and without stairs, each match must sit at the distance
+// Router::route gives and the matches must be the closest facilities in order.
+// The QueryLimits budget and cancel flag must stop the search like a route's.
+
+#include "pathfinder_internal.h"
+#include "test_util.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+int main() {
+    std::shared_ptr<const Router> router = Router::load(RouterOptions());
+    const Facility categories[] = {FACILITY_WASHROOM, FACILITY_EXIT_GATE, FACILITY_MEDICAL, FACILITY_FOOD};
+
+    for (int profile = 0; profile < NUM_CAMPUS_PROFILES; ++profile) {
+        Graph graph(CAMPUS_NODES);
+        loadCampusGraph(graph, profile, "none");
+        for (Facility category : categories) {
+            std::vector<int> tagged;
+            for (int node : graph.facilityNodes[Graph::facilityIndex(category)])
+                tagged.push_back(graph.extId[node]);
+
+            for (int hour : {8, 12}) {
+                for (int avoid : {0, (int)ACCESS_STAIRS}) {
+                    QueryLimits limits;
+                    limits.avoid = avoid;
+                    int wrong = 0;
+                    for (int source = 0; source < CAMPUS_NODES; ++source) {
+                        std::vector<int> expected;
+                        RouteResult route;
+                        for (int facility : tagged) {
+                            router->route(source, facility, profile, hour * 3600, route, limits);
+                            if (route.found)
+                                expected.push_back(route.distance);
+                        }
+                        std::sort(expected.begin(), expected.end());
+
+                        for (int k : {1, (int)tagged.size()}) {
+                            std::vector<FacilityResult> matches;
+                            router->nearest(source, category, k, profile, hour * 3600, matches, limits);
+                            size_t wanted = std::min((size_t)std::max(k, 0), expected.size());
+                            bool ok = matches.size() == wanted;
+                            for (size_t i = 0; ok && i < matches.size(); ++i) {
+                                router->route(source, matches[i].node, profile, hour * 3600, route, limits);
+                                ok = matches[i].distance == expected[i] && route.distance == expected[i] &&
+                                     !matches[i].path.empty() && matches[i].path.front() == source &&
+                                     matches[i].path.back() == matches[i].node;
+                            }
+                            wrong += !ok;
+                        }
+                    }
+                    check(wrong == 0, "profile " + std::to_string(profile) + ", category " +
+                          std::to_string((int)category) + " at " + std::to_string(hour) + ":00, avoid " +
+                          std::to_string(avoid) + ": " + std::to_string(wrong) + " answers differ");
+                }
+            }
+        }
+    }
+
+    // A budget of one expansion settles only the source, and a raised cancel flag
+    // stops a search at its first poll, after 16 expansions
+    for (int profile = 0; profile < NUM_CAMPUS_PROFILES; ++profile) {
+        std::string where = "profile " + std::to_string(profile);
+        int k = CAMPUS_NODES;
+        std::vector<FacilityResult> matches;
+        bool exhausted = false;
+        QueryLimits limits;
+        limits.maxExpansions = 1;
+        bool ok = router->nearest(35, FACILITY_FOOD, k, profile, 12 * 3600, matches, limits, &exhausted);
+        check(ok && !matches.empty() && matches[0].node == 35, where + ": match at the source lost");
+
+        // The first query that needs more than 16 expansions
+        int source = 0, c = 0;
+        limits.maxExpansions = 16;
+        while (c < 4 && !(router->nearest(source, categories[c], k, profile, 12 * 3600, matches, limits, &exhausted) &&
+                          exhausted)) {
+            if (++source == CAMPUS_NODES) {
+                source = 0;
+                c++;
+            }
+        }
+        check(c < 4, where + ": no query longer than 16 expansions");
+        if (c == 4)
+            continue;
+        std::vector<FacilityResult> full;
+        limits.maxExpansions = 0;
+        check(router->nearest(source, categories[c], k, profile, 12 * 3600, full, limits, &exhausted) && !exhausted &&
+              full.size() >= matches.size(), where + ": unlimited search stopped");
+        limits.maxExpansions = 1;
+        check(router->nearest(source, categories[c], k, profile, 12 * 3600, matches, limits, &exhausted) &&
+              exhausted && matches.size() <= 1, where + ": budget not applied");
+
+        std::atomic<bool> cancel(true);
+        limits.maxExpansions = 0;
+        limits.cancel = &cancel;
+        check(!router->nearest(source, categories[c], k, profile, 12 * 3600, matches, limits), where + ": cancel ignored");
+    }
+    return testResult();
+}
@@ -0,0 +1,78 @@
+// Checks that renumbering is invisible from outside: a Router built with the bfs,
+// rcm or hilbert node order must answer every query exactly as one without it,
+// in the same public node numbers. Each order must also be a permutation whose
+// extId/intId maps invert each other.
+
+#include "pathfinder_internal.h"
+#include "test_util.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+static bool sameRoute(const RouteResult& a, const RouteResult& b) {
+    return a.found == b.found && a.distance == b.distance && a.path == b.path;
+}
+
+static bool sameMatches(const std::vector<FacilityResult>& a, const std::vector<FacilityResult>& b) {
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].node != b[i].node || a[i].distance != b[i].distance || a[i].path != b[i].path)
+            return false;
+    }
+    return true;
+}
+
+int main() {
+    const Facility categories[] = {FACILITY_WASHROOM, FACILITY_EXIT_GATE, FACILITY_MEDICAL, FACILITY_FOOD};
+    const char* clicks[] = {"300,200", "1000,600", "50,50", "1200,800"};
+    std::shared_ptr<const Router> plain = Router::load(RouterOptions());
+
+    for (const std::string order : {"bfs", "rcm", "hilbert"}) {
+        RouterOptions options;
+        options.order = order;
+        std::shared_ptr<const Router> renumbered = Router::load(options);
+
+        for (int profile = 0; profile < NUM_CAMPUS_PROFILES; ++profile) {
+            std::string where = order + ", profile " + std::to_string(profile);
+
+            Graph graph(CAMPUS_NODES);
+            loadCampusGraph(graph, profile, order);
+            std::vector<bool> seen(CAMPUS_NODES, false);
+            int badIds = 0;
+            for (int v = 0; v < CAMPUS_NODES; ++v) {
+                int ext = graph.extId[v];
+                if (ext < 0 || ext >= CAMPUS_NODES || seen[ext] || graph.intId[ext] != v)
+                    badIds++;
+                else
+                    seen[ext] = true;
+            }
+            check(badIds == 0, where + ": " + std::to_string(badIds) + " nodes with bad id maps");
+
+            int routes = 0, nearest = 0, snapped = 0;
+            RouteResult a, b;
+            for (int s = 0; s < CAMPUS_NODES; s += 7) {
+                for (int t = 0; t < CAMPUS_NODES; ++t) {
+                    plain->route(s, t, profile, 9 * 3600, a);
+                    renumbered->route(s, t, profile, 9 * 3600, b);
+                    routes += !sameRoute(a, b);
+                }
+                for (Facility category : categories) {
+                    std::vector<FacilityResult> x, y;
+                    plain->nearest(s, category, 2, profile, 12 * 3600, x);
+                    renumbered->nearest(s, category, 2, profile, 12 * 3600, y);
+                    nearest += !sameMatches(x, y);
+                }
+            }
+            for (const char* click : clicks) {
+                int node = plain->resolveNode(click, profile);
+                snapped += node < 0 || node != renumbered->resolveNode(click, profile);
+            }
+            check(routes == 0, where + ": " + std::to_string(routes) + " routes differ");
+            check(nearest == 0, where + ": " + std::to_string(nearest) + " nearest-facility answers differ");
+            check(snapped == 0, where + ": " + std::to_string(snapped) + " map clicks snap elsewhere");
+        }
+    }
+    return testResult();
+}
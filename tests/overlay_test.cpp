@@ -0,0 +1,89 @@
+// Checks of MultiLevelOverlay (pathfinder_internal.h) on a small grid with one-way
+// arcs and an unreachable node: every pair is routed through the overlay and
+// compared with A*, and every unpacked path is walked arc by arc. The same checks
+// run after re-customizing changed weights and on a step-free copy.
+
+#include "pathfinder_internal.h"
+#include "test_util.h"
+
+#include <climits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+const int SIDE = 12;
+
+static void checkAllPairs(Graph& graph, MultiLevelOverlay& overlay, const std::string& label) {
+    OverlayWorkspace ws(graph.numNodes);
+    SearchControl control;
+    control.avoid = overlay.avoid;
+    std::vector<int> parent, path;
+    int wrong = 0;
+    for (int s = 0; s < graph.numNodes; ++s) {
+        for (int t = 0; t < graph.numNodes; ++t) {
+            int distance = overlay.route(s, t, ws, &path);
+            if (distance != aStarSearch(graph, s, t, parent, 0, &control)) {
+                wrong++;
+                continue;
+            }
+            if (distance == INT_MAX)
+                continue;
+            long long cost = 0;
+            for (size_t k = 1; k < path.size(); ++k)
+                cost += graph.arcCost(path[k - 1], path[k], overlay.avoid);
+            if (path.front() != s || path.back() != t || cost != distance)
+                wrong++;
+        }
+    }
+    check(wrong == 0, label + ": " + std::to_string(wrong) + " routes differ from A*");
+}
+
+int main() {
+    // SIDE x SIDE grid plus one node without arcs; every seventh row link is one-way
+    Graph graph(SIDE * SIDE + 1);
+    std::mt19937 rng(3);
+    for (int r = 0; r < SIDE; ++r) {
+        for (int c = 0; c < SIDE; ++c) {
+            int u = r * SIDE + c;
+            graph.setPosition(u, c, r);
+            if (c + 1 < SIDE) {
+                if (u % 7 == 0)
+                    graph.addArc(u, u + 1, 1 + rng() % 50);
+                else
+                    graph.addEdge(u, u + 1, 1 + rng() % 50);
+            }
+            if (r + 1 < SIDE)
+                graph.addEdge(u, u + SIDE, 1 + rng() % 50, 1 + rng() % 50);
+        }
+    }
+    graph.setPosition(SIDE * SIDE, 0, SIDE);
+    graph.finalize();
+
+    MultiLevelOverlay overlay(graph, {8, 32, 128});
+    check(overlay.levels.size() == 3, "three levels");
+    overlay.customize();
+    checkAllPairs(graph, overlay, "customized");
+
+    std::vector<std::pair<int, int>> changed;
+    for (int i = 0; i < 20; ++i) {
+        int u = rng() % (SIDE * SIDE);
+        int v = graph.head[graph.firstOut[u]];
+        graph.setArcWeight(u, v, 1 + rng() % 200);
+        changed.push_back(std::make_pair(u, v));
+    }
+    graph.finalize();
+    overlay.customizeChanged(changed);
+    checkAllPairs(graph, overlay, "re-customized");
+
+    for (int u = 0; u < SIDE * SIDE; u += 5) {
+        int v = graph.head[graph.firstOut[u]];
+        graph.setArcAccess(u, v, ACCESS_STAIRS);
+        graph.setArcAccess(v, u, ACCESS_STAIRS);
+    }
+    MultiLevelOverlay stepFree = overlay;
+    stepFree.customizeAvoiding(ACCESS_STAIRS);
+    checkAllPairs(graph, stepFree, "step-free");
+
+    return testResult();
+}
@@ -0,0 +1,73 @@
+// Checks of the compact path encoding and PackedRoutes (pathfinder.h): round trips
+// of extreme node numbers, several paths in one buffer, truncated input, and the
+// flags and index range of stored routes.
+
+#include "pathfinder.h"
+#include "test_util.h"
+
+#include <climits>
+#include <string>
+#include <vector>
+
+static bool sameRoute(const RouteResult& a, const RouteResult& b) {
+    return a.found == b.found && a.distance == b.distance && a.path == b.path && a.optimal == b.optimal &&
+           a.exhausted == b.exhausted;
+}
+
+int main() {
+    std::vector<std::vector<int>> paths = {
+        {},
+        {7},
+        {0, 1, 2, 3},
+        {239, 12, 140, 0},
+        {0, INT_MAX, INT_MIN, 0, INT_MIN, INT_MAX},
+    };
+
+    std::string bytes;
+    for (const std::vector<int>& path : paths)
+        encodePath(path, bytes);
+    size_t pos = 0;
+    std::vector<int> decoded;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        check(decodePath(bytes, pos, decoded) && decoded == paths[i], "path " + std::to_string(i) + " round trip");
+    }
+    check(pos == bytes.size(), "decoding stops at the end of the buffer");
+    check(!decodePath(bytes, pos, decoded), "decoding past the end fails");
+
+    std::string last;
+    encodePath(paths.back(), last);
+    for (size_t length = 0; length < last.size(); ++length) {
+        pos = 0;
+        check(!decodePath(last.substr(0, length), pos, decoded), "truncated to " + std::to_string(length) + " bytes");
+    }
+    pos = 0;
+    check(!decodePath(std::string(12, '\xff'), pos, decoded), "unterminated varint");
+
+    std::vector<RouteResult> routes(4);
+    routes[0].found = true;
+    routes[0].distance = 42;
+    routes[0].path = {0, 12, 139};
+    routes[1].found = true;
+    routes[1].distance = 50;
+    routes[1].path = {139, 12, 0};
+    routes[1].optimal = false;
+    routes[2].exhausted = true;
+    routes[3].found = true;
+    routes[3].distance = INT_MAX;
+    routes[3].path = {5};
+
+    PackedRoutes packed;
+    for (size_t i = 0; i < routes.size(); ++i)
+        check(packed.add(routes[i]) == (int)i, "index of route " + std::to_string(i));
+    packed.shrink();
+    check(packed.size() == (int)routes.size(), "size");
+    RouteResult out;
+    for (size_t i = 0; i < routes.size(); ++i)
+        check(packed.get(i, out) && sameRoute(out, routes[i]), "route " + std::to_string(i) + " round trip");
+    check(!packed.get(-1, out) && !packed.get(packed.size(), out), "index out of range");
+
+    packed.clear();
+    check(packed.size() == 0 && !packed.get(0, out), "clear");
+
+    return testResult();
+}
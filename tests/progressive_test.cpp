@@ -0,0 +1,149 @@
+// Checks of the callbacks of Router::routeProgressive (pathfinder.h) on the campus:
+// a quick route then the optimal one, a single answer for an unreachable target or
+// a search without weighting, the quick route again with exhausted set when the
+// budget runs out in the second search, and no answer when cancelled. A query
+// preempted after its quick route, as the server does to kiosk streams, must not
+// report the quick route again when it is run again with its ProgressiveState.
+
+#include "pathfinder.h"
+#include "test_util.h"
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+const int PROFILE = PROFILE_WALK_RAIN;
+const int DEPARTURE = 9 * 3600 + 30 * 60;
+
+// Every result routeProgressive reports, in order. ok is its return value.
+static std::vector<RouteResult> progressive(const Router& router, int source, int target, double suboptimality,
+                                            const QueryLimits& limits, bool& ok, ProgressiveState* state = nullptr) {
+    std::vector<RouteResult> results;
+    ok = router.routeProgressive(source, target, PROFILE, DEPARTURE, suboptimality,
+                                 [&](const RouteResult& result) { results.push_back(result); }, limits, state);
+    return results;
+}
+
+static bool connects(const RouteResult& route, int source, int target) {
+    return route.found && !route.path.empty() && route.path.front() == source && route.path.back() == target;
+}
+
+int main() {
+    std::string error;
+    std::shared_ptr<const Router> router = Router::load(RouterOptions(), &error);
+    if (!router) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    RouteResult best;
+    router->route(0, 139, PROFILE, DEPARTURE, best);
+    check(best.found, "campus route 0 -> 139");
+    bool ok;
+
+    // Quick route, then the optimal one
+    std::vector<RouteResult> results = progressive(*router, 0, 139, 1.5, QueryLimits(), ok);
+    check(ok && results.size() == 2, "quick and optimal routes");
+    if (results.size() == 2) {
+        check(connects(results[0], 0, 139) && !results[0].optimal && !results[0].exhausted, "quick route first");
+        check(connects(results[1], 0, 139) && results[1].optimal && !results[1].exhausted, "optimal route second");
+        check(results[1].distance == best.distance && results[1].distance <= results[0].distance,
+              "optimal route costs the optimum");
+    }
+
+    // Without weighting the first search is already optimal
+    results = progressive(*router, 0, 139, 1.0, QueryLimits(), ok);
+    check(ok && results.size() == 1 && results[0].optimal && results[0].distance == best.distance,
+          "one optimal route at suboptimality 1");
+
+    // An unreachable target is reported once
+    int unreachable = -1;
+    RouteResult route;
+    for (int target = 0; target < router->nodeCount() && unreachable < 0; ++target) {
+        router->route(0, target, PROFILE, DEPARTURE, route);
+        if (!route.found)
+            unreachable = target;
+    }
+    check(unreachable >= 0, "a campus node unreachable from 0");
+    if (unreachable >= 0) {
+        results = progressive(*router, 0, unreachable, 1.5, QueryLimits(), ok);
+        check(ok && results.size() == 1 && !results[0].found && !results[0].exhausted,
+              "unreachable target reported once");
+    }
+
+    // Growing budgets: first the quick search runs out, then the optimal one (the
+    // quick route comes again, exhausted), and finally both complete
+    bool quickExhausted = false, optimalExhausted = false;
+    for (long long budget = 1; budget < 100000; ++budget) {
+        QueryLimits limits;
+        limits.maxExpansions = budget;
+        results = progressive(*router, 0, 139, 1.5, limits, ok);
+        std::string at = " with a budget of " + std::to_string(budget);
+        if (!ok || results.empty()) {
+            check(false, "no answer" + at);
+            break;
+        }
+        if (results.size() == 1) {
+            check(!results[0].found && results[0].exhausted && !optimalExhausted, "quick search exhausted" + at);
+            quickExhausted = true;
+            continue;
+        }
+        check(results.size() == 2 && connects(results[0], 0, 139) && !results[0].optimal &&
+              !results[0].exhausted, "quick route first" + at);
+        if (results.size() == 2 && results[1].exhausted) {
+            check(!results[1].optimal && results[1].distance == results[0].distance &&
+                  results[1].path == results[0].path, "quick route again when exhausted" + at);
+            optimalExhausted = true;
+            continue;
+        }
+        check(results.size() == 2 && results[1].optimal && results[1].distance == best.distance,
+              "optimal route within the budget" + at);
+        break;
+    }
+    check(quickExhausted && optimalExhausted, "both searches ran out of some budget");
+
+    // Cancelled before it starts: no answer, and false
+    std::atomic<bool> cancel(true);
+    QueryLimits cancelled;
+    cancelled.cancel = &cancel;
+    results = progressive(*router, 0, 139, 1.5, cancelled, ok);
+    check(!ok && results.empty(), "cancelled query");
+
+    // Preempted during the optimal search: the rerun reports only the optimal route
+    ProgressiveState state;
+    std::atomic<bool> preempt(false);
+    QueryLimits preemptible;
+    preemptible.cancel = &preempt;
+    results.clear();
+    ok = router->routeProgressive(0, 139, PROFILE, DEPARTURE, 1.5, [&](const RouteResult& result) {
+        results.push_back(result);
+        preempt = true;
+    }, preemptible, &state);
+    check(!ok && results.size() == 1 && !results[0].optimal && state.quickReported, "preempted after the quick route");
+    preempt = false;
+    std::vector<RouteResult> resumed = progressive(*router, 0, 139, 1.5, preemptible, ok, &state);
+    check(ok && resumed.size() == 1 && resumed[0].optimal && resumed[0].distance == best.distance,
+          "rerun reports the quick route again");
+
+    // A rerun that runs out of budget still ends with the quick route, exhausted
+    QueryLimits tight;
+    tight.maxExpansions = 1;
+    resumed = progressive(*router, 0, 139, 1.5, tight, ok, &state);
+    check(ok && resumed.size() == 1 && resumed[0].exhausted && !resumed[0].optimal && !results.empty() &&
+          resumed[0].path == results[0].path, "exhausted rerun");
+
+    // Preempted before the quick route was found: the rerun starts over
+    ProgressiveState fresh;
+    preempt = true;
+    results = progressive(*router, 0, 139, 1.5, preemptible, ok, &fresh);
+    check(!ok && results.empty() && !fresh.quickReported, "preempted before the quick route");
+    preempt = false;
+    results = progressive(*router, 0, 139, 1.5, preemptible, ok, &fresh);
+    check(ok && results.size() == 2 && !results[0].optimal && results[1].optimal, "rerun of an early preemption");
+
+    results = progressive(*router, 0, router->nodeCount(), 1.5, QueryLimits(), ok);
+    check(!ok && results.empty(), "invalid node");
+
+    return testResult();
+}
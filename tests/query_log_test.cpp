@@ -0,0 +1,172 @@
+// Checks of the query log: QueryLogRing must hand records to the consumer in
+// order across wrap-around, refuse pushes when full and lose nothing under
+// several producers; QueryLog must write what record() was given so readQueryLog
+// gets it back, and count what a full ring drops; readQueryLog must reject files
+// that are not a whole number of tagged records.
+
+#include "pathfinder_internal.h"
+#include "test_util.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static QueryRecord makeRecord(int i) {
+    QueryRecord r;
+    r.timestamp = 1700000000000000LL + i;
+    r.source = i;
+    r.target = 1000 + i;
+    r.minute = i % 1440;
+    r.type = i % 3;
+    r.weather = i % 2;
+    return r;
+}
+
+static bool sameRecord(const QueryRecord& a, const QueryRecord& b) {
+    return a.timestamp == b.timestamp && a.source == b.source && a.target == b.target &&
+           a.minute == b.minute && a.type == b.type && a.weather == b.weather;
+}
+
+static void checkRing() {
+    // Fill and drain a 4-slot ring ten times, so the positions wrap around
+    QueryLogRing ring(4);
+    QueryRecord r;
+    int next = 0, popped = 0, outOfOrder = 0;
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 4; ++i)
+            check(ring.push(makeRecord(next++)), "push into a ring with room failed");
+        check(!ring.push(makeRecord(-1)), "push into a full ring succeeded");
+        while (ring.pop(r))
+            outOfOrder += r.source != popped++;
+    }
+    check(popped == 40 && outOfOrder == 0, "ring popped " + std::to_string(popped) + " records, " +
+          std::to_string(outOfOrder) + " out of order");
+    check(!ring.pop(r), "pop from an empty ring succeeded");
+
+    // Several producers; every record arrives exactly once and each producer's
+    // records arrive in the order it pushed them
+    const int PRODUCERS = 4, EACH = 20000;
+    QueryLogRing shared(256);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&shared, p] {
+            for (int i = 0; i < EACH; ++i) {
+                QueryRecord record = makeRecord(i);
+                record.target = p;
+                while (!shared.push(record))
+                    std::this_thread::yield();
+            }
+        });
+    }
+    std::vector<int> expected(PRODUCERS, 0);
+    int received = 0, wrong = 0;
+    while (received < PRODUCERS * EACH) {
+        if (!shared.pop(r)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (r.target < 0 || r.target >= PRODUCERS || r.source != expected[r.target])
+            wrong++;
+        else
+            expected[r.target]++;
+        received++;
+    }
+    for (std::thread& producer : producers)
+        producer.join();
+    check(wrong == 0 && !shared.pop(r), std::to_string(wrong) + " records lost, repeated or reordered by producers");
+}
+
+static void checkEncoding() {
+    QueryRecord r = makeRecord(1439);
+    r.source = -1;
+    r.timestamp = -5;
+    unsigned char bytes[QUERY_RECORD_BYTES];
+    encodeQueryRecord(r, bytes);
+    QueryRecord back;
+    check(bytes[0] == QUERY_RECORD_TAG, "record does not start with the tag");
+    check(decodeQueryRecord(bytes, back) && sameRecord(r, back), "record changed by encode and decode");
+    bytes[0] = 0;
+    check(!decodeQueryRecord(bytes, back), "record without the tag decoded");
+}
+
+static void checkRoundTrip(const std::string& path) {
+    std::remove(path.c_str());
+    {
+        QueryLog log(path);
+        check(log.isOpen(), "cannot open " + path);
+        log.record(12, 140, 9 * 3600 + 30 * 60, 1, 0);
+        log.record(0, 5, 23 * 3600 + 59 * 60 + 59, 2, 1);
+        log.record(77, 77, 0, 0, 1);
+    }   // The destructor drains the ring
+
+    std::vector<QueryRecord> records;
+    std::string error;
+    check(isQueryLog(path), path + " not detected as a query log");
+    check(readQueryLog(path, records, error), "readQueryLog: " + error);
+    check(records.size() == 3, std::to_string(records.size()) + " records read back, expected 3");
+    if (records.size() == 3) {
+        check(records[0].source == 12 && records[0].target == 140 && records[0].minute == 570 &&
+              records[0].type == 1 && records[0].weather == 0, "first record changed");
+        check(records[1].source == 0 && records[1].target == 5 && records[1].minute == 1439 &&
+              records[1].type == 2 && records[1].weather == 1, "second record changed");
+        check(records[2].source == 77 && records[2].minute == 0, "third record changed");
+        check(records[0].timestamp > 0 && records[0].timestamp <= records[2].timestamp, "timestamps out of order");
+    }
+
+    // A second log appends to the same file
+    {
+        QueryLog log(path);
+        log.record(1, 2, 60, 0, 0);
+    }
+    records.clear();
+    check(readQueryLog(path, records, error) && records.size() == 4 && records[3].source == 1,
+          "second log did not append");
+
+    // Truncated and foreign files
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::app);
+        file.put((char)QUERY_RECORD_TAG);
+    }
+    records.clear();
+    check(!readQueryLog(path, records, error) && error.find("truncated") != std::string::npos,
+          "truncated log accepted");
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << "12 140 1 09:30 0\n12 140 1 09:30 0\n";
+    }
+    records.clear();
+    check(!isQueryLog(path), "text workload detected as a query log");
+    check(!readQueryLog(path, records, error), "text workload read as a query log");
+    std::remove(path.c_str());
+    check(!readQueryLog(path, records, error), "missing log read");
+}
+
+// Records pushed faster than a 2-slot ring is drained are dropped and counted,
+// and every one that was not dropped reaches the file
+static void checkDropped(const std::string& path) {
+    std::remove(path.c_str());
+    long long dropped;
+    {
+        QueryLog log(path, 2, std::chrono::milliseconds(1000));
+        for (int i = 0; i < 100; ++i)
+            log.record(i, i, 0, 0, 0);
+        dropped = log.droppedRecords();
+    }
+    std::vector<QueryRecord> records;
+    std::string error;
+    check(readQueryLog(path, records, error), "readQueryLog: " + error);
+    check(dropped > 0 && records.size() + dropped == 100, std::to_string(records.size()) + " written and " +
+          std::to_string(dropped) + " dropped of 100");
+    std::remove(path.c_str());
+}
+
+int main() {
+    checkRing();
+    checkEncoding();
+    checkRoundTrip("query_log_test.log");
+    checkDropped("query_log_test_dropped.log");
+    return testResult();
+}
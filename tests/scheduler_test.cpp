@@ -0,0 +1,155 @@
+// Checks of the QueryScheduler of the built-in server. Identical queries in flight
+// together must share one computation and every client must get its answer;
+// kiosk queries from one source must wait for the batching window and then be
+// answered by one sweep, unless maxBatch targets flush them early; emergency
+// queries must skip the window; a full queue must shed kiosk queries and make
+// room for emergency ones. A scheduler without threads shows the queue state; one
+// with a thread shows what the clients receive. The server is Linux only, so
+// elsewhere the test is reported as skipped.
+
+#include "pathfinder_internal.h"
+#include "pathfinder_server.h"
+#include "test_util.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#ifdef __linux__
+const int DEPARTURE = 9 * 3600;
+
+// Completions posted so far, in order
+static std::vector<RouteCompletion> completions(WorkerInbox& inbox) {
+    std::lock_guard<std::mutex> guard(inbox.lock);
+    return inbox.items;
+}
+
+// Wait up to `limit` for `count` completions
+static std::vector<RouteCompletion> waitFor(WorkerInbox& inbox, size_t count, std::chrono::milliseconds limit) {
+    auto end = std::chrono::steady_clock::now() + limit;
+    while (completions(inbox).size() < count && std::chrono::steady_clock::now() < end)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return completions(inbox);
+}
+
+static const RouteCompletion* forClient(const std::vector<RouteCompletion>& items, int fd) {
+    for (const RouteCompletion& item : items) {
+        if (item.fd == fd)
+            return &item;
+    }
+    return nullptr;
+}
+
+// The answer the CLI would print for the query
+static std::string expectedAnswer(const Router& router, int profile, int source, int target) {
+    RouteResult route;
+    router.route(source, target, profile, DEPARTURE, route);
+    std::string text;
+    formatRoute(route, text);
+    return trimmed(text);
+}
+
+// Queue state with no thread to answer anything
+static void checkQueue(const Router& router, int profile) {
+    WorkerInbox inbox;
+    AdmissionLimits limits;
+    limits.maxQueued = 4;
+    QueryScheduler scheduler(router, 0, std::chrono::seconds(10), 64, limits);
+
+    check(scheduler.submit(PRIORITY_KIOSK, profile, 0, 0, DEPARTURE, 139, RouteWaiter{&inbox, 1, 1}), "first query shed");
+    check(scheduler.submit(PRIORITY_KIOSK, profile, 0, 0, DEPARTURE, 139, RouteWaiter{&inbox, 2, 2}), "identical query shed");
+    check(scheduler.submit(PRIORITY_KIOSK, profile, 0, 0, DEPARTURE, 50, RouteWaiter{&inbox, 3, 3}), "same-source query shed");
+    check(scheduler.submit(PRIORITY_KIOSK, profile, 0, 0, DEPARTURE + 60, 50, RouteWaiter{&inbox, 4, 4}),
+          "later departure shed");
+    check(scheduler.submit(PRIORITY_KIOSK, profile, 0, 7, DEPARTURE, 50, RouteWaiter{&inbox, 5, 5}), "other source shed");
+
+    auto first = std::make_tuple((int)PRIORITY_KIOSK, profile, 0, 0, DEPARTURE, 139);
+    check(scheduler.inFlight[first].size() == 2, "identical queries not coalesced");
+    check(scheduler.queued == 4, std::to_string(scheduler.queued) + " queries queued, expected 4");
+    check(scheduler.batches.size() == 3, std::to_string(scheduler.batches.size()) + " batches, expected 3");
+    std::vector<int> targets = scheduler.batches[std::make_tuple((int)PRIORITY_KIOSK, profile, 0, 0, DEPARTURE)].targets;
+    check(targets == std::vector<int>({139, 50}), "same-source queries not batched in arrival order");
+
+    // The queue is full: a new kiosk query is shed, one identical to a queued
+    // query still joins it, and an emergency query evicts the newest kiosk query
+    check(!scheduler.submit(PRIORITY_KIOSK, profile, 0, 9, DEPARTURE, 50, RouteWaiter{&inbox, 6, 6}),
+          "kiosk query admitted to a full queue");
+    check(scheduler.submit(PRIORITY_KIOSK, profile, 0, 0, DEPARTURE, 50, RouteWaiter{&inbox, 7, 7}),
+          "identical query shed by a full queue");
+    check(scheduler.submit(PRIORITY_EMERGENCY, profile, 0, 9, DEPARTURE, 50, RouteWaiter{&inbox, 8, 8}),
+          "emergency query shed");
+    std::vector<RouteCompletion> shed = completions(inbox);
+    check(shed.size() == 1 && shed[0].fd == 5 && shed[0].shed, "newest kiosk query not evicted for the emergency one");
+    check(scheduler.queued == 4, "evicted query still counted");
+    auto emergency = scheduler.batches.find(std::make_tuple((int)PRIORITY_EMERGENCY, profile, 0, 9, DEPARTURE));
+    check(emergency != scheduler.batches.end() && emergency->second.deadline <= std::chrono::steady_clock::now(),
+          "emergency query waits for the batching window");
+}
+
+// What the clients receive from a scheduler with one thread
+static void checkAnswers(const Router& router, int profile) {
+    // Four clients, three distinct targets: maxBatch 3 flushes the batch long
+    // before its 10 s window, in one sweep, and both clients of 139 get the answer
+    {
+        WorkerInbox inbox;
+        QueryScheduler scheduler(router, 1, std::chrono::seconds(10), 3, AdmissionLimits());
+        scheduler.submit(PRIORITY_KIOSK, profile, 0, 0, DEPARTURE, 139, RouteWaiter{&inbox, 1, 1});
+        scheduler.submit(PRIORITY_KIOSK, profile, 0, 0, DEPARTURE, 139, RouteWaiter{&inbox, 2, 2});
+        scheduler.submit(PRIORITY_KIOSK, profile, 0, 0, DEPARTURE, 50, RouteWaiter{&inbox, 3, 3});
+        scheduler.submit(PRIORITY_KIOSK, profile, 0, 0, DEPARTURE, 80, RouteWaiter{&inbox, 4, 4});
+        std::vector<RouteCompletion> items = waitFor(inbox, 4, std::chrono::seconds(5));
+        check(items.size() == 4, std::to_string(items.size()) + " of 4 clients answered after a full batch");
+        const int targets[] = {139, 139, 50, 80};
+        for (int fd = 1; fd <= 4; ++fd) {
+            const RouteCompletion* item = forClient(items, fd);
+            check(item != nullptr && !item->shed && item->last && item->connId == (unsigned long long)fd &&
+                  item->result == expectedAnswer(router, profile, 0, targets[fd - 1]),
+                  "client " + std::to_string(fd) + " got a wrong answer");
+        }
+        std::lock_guard<std::mutex> guard(scheduler.lock);
+        check(scheduler.batchesAnswered == 1, std::to_string(scheduler.batchesAnswered) + " sweeps for one batch");
+        check(scheduler.inFlight.empty() && scheduler.queued == 0, "answered queries still queued");
+    }
+
+    // Below maxBatch a kiosk query waits for its window; an emergency query does not
+    {
+        WorkerInbox inbox;
+        QueryScheduler scheduler(router, 1, std::chrono::seconds(10), 64, AdmissionLimits());
+        scheduler.submit(PRIORITY_KIOSK, profile, 0, 0, DEPARTURE, 139, RouteWaiter{&inbox, 1, 1});
+        scheduler.submit(PRIORITY_EMERGENCY, profile, 0, 5, DEPARTURE, 139, RouteWaiter{&inbox, 2, 2});
+        std::vector<RouteCompletion> items = waitFor(inbox, 1, std::chrono::seconds(5));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        items = completions(inbox);
+        check(items.size() == 1 && items[0].fd == 2 && items[0].result == expectedAnswer(router, profile, 5, 139),
+              "emergency query not answered at once, or kiosk query answered before its window");
+    }
+
+    // A short window flushes a lone kiosk query
+    {
+        WorkerInbox inbox;
+        QueryScheduler scheduler(router, 1, std::chrono::milliseconds(5), 64, AdmissionLimits());
+        scheduler.submit(PRIORITY_KIOSK, profile, 0, 0, DEPARTURE, 139, RouteWaiter{&inbox, 1, 1});
+        std::vector<RouteCompletion> items = waitFor(inbox, 1, std::chrono::seconds(5));
+        check(items.size() == 1 && items[0].result == expectedAnswer(router, profile, 0, 139),
+              "lone kiosk query not answered after its window");
+    }
+}
+
+int main() {
+    std::shared_ptr<const Router> router = Router::load(RouterOptions());
+    int profile = campusProfile(1, 0);
+    checkQueue(*router, profile);
+    checkAnswers(*router, profile);
+    return testResult();
+}
+#else
+int main() {
+    std::cout << "The built-in server needs Linux, skipped" << std::endl;
+    return 77;
+}
+#endif
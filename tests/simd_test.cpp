@@ -0,0 +1,90 @@
+// Checks of the SIMD kernels: the relax kernel behind aStarSearch and the bulk
+// kernel behind distanceMatrix must give the distances of a plain Dijkstra. The
+// kernels are picked once per process, so ctest runs this test once per
+// PATHFINDER_SIMD level; a level the CPU lacks is reported as skipped. The graphs
+// are the static campus profiles, a synthetic grid and a random graph whose nodes
+// have enough arcs for the 8-wide AVX2 relax loop.
+
+#include "bench/benchmarks.h"
+#include "pathfinder_internal.h"
+#include "test_util.h"
+
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+const int SKIPPED = 77;   // SKIP_RETURN_CODE of the ctest entries
+
+// Distances from src over the base weights, without any kernel
+static std::vector<int> referenceDistances(Graph& graph, int src) {
+    std::vector<int> dist(graph.numNodes, INT_MAX);
+    MinHeap minHeap;
+    dist[src] = 0;
+    minHeap.insert(MinHeapNode(src, 0));
+    while (!minHeap.isEmpty()) {
+        MinHeapNode top = minHeap.extractMin();
+        int u = top.v;
+        if (top.f != dist[u])
+            continue;
+        for (int e = graph.firstOut[u]; e < graph.firstOut[u + 1]; ++e) {
+            int v = graph.head[e];
+            if (dist[u] + graph.outWeight[e] < dist[v]) {
+                dist[v] = dist[u] + graph.outWeight[e];
+                minHeap.insert(MinHeapNode(v, dist[v]));
+            }
+        }
+    }
+    return dist;
+}
+
+static void checkKernels(Graph& graph, const std::string& label, int sourceStep, int targetStep) {
+    graph.finalize();
+    std::vector<int> sources;
+    for (int v = 0; v < graph.numNodes; v += sourceStep)
+        sources.push_back(v);
+    std::vector<std::vector<int>> bulk = distanceMatrix(graph, sources, 0, 0);
+
+    std::vector<int> parent;
+    int wrongSearch = 0, wrongBulk = 0;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        std::vector<int> expected = referenceDistances(graph, sources[i]);
+        wrongBulk += bulk[i] != expected;
+        for (int t = 0; t < graph.numNodes; t += targetStep)
+            wrongSearch += aStarSearch(graph, sources[i], t, parent) != expected[t];
+    }
+    check(wrongSearch == 0, label + ": " + std::to_string(wrongSearch) + " aStarSearch distances differ");
+    check(wrongBulk == 0, label + ": " + std::to_string(wrongBulk) + " distanceMatrix rows differ");
+}
+
+int main() {
+    const char* requested = std::getenv("PATHFINDER_SIMD");
+    if (requested != nullptr && std::string(requested) != simdLevelName()) {
+        std::cout << "PATHFINDER_SIMD=" << requested << " is not supported here, skipped" << std::endl;
+        return SKIPPED;
+    }
+    std::cout << "Kernels: " << simdLevelName() << std::endl;
+
+    for (int profile = 0; profile < NUM_CAMPUS_PROFILES; ++profile) {
+        Graph campus(CAMPUS_NODES);
+        loadCampusGraph(campus, profile, "none");
+        if (!campus.timeDependent())
+            checkKernels(campus, "campus profile " + std::to_string(profile), 1, 1);
+    }
+
+    Graph grid = syntheticGrid(48, 1);
+    checkKernels(grid, "48x48 grid", 97, 11);
+
+    // Out-degrees from 0 to 20, so the vector loops and their scalar tails both run
+    std::mt19937 rng(3);
+    Graph dense(1500);
+    for (int u = 0; u < dense.numNodes; ++u) {
+        int degree = rng() % 21;
+        for (int i = 0; i < degree; ++i)
+            dense.addArc(u, rng() % dense.numNodes, 1 + rng() % 1000);
+    }
+    checkKernels(dense, "random graph", 61, 7);
+    return testResult();
+}
@@ -0,0 +1,28 @@
+// Checks shared by the engine tests. A test calls check() for each expectation and
+// returns testResult() from main: every failed check is printed, and the exit
+// status is non-zero if any failed.
+
+#ifndef PATHFINDER_TEST_UTIL_H
+#define PATHFINDER_TEST_UTIL_H
+
+#include <iostream>
+#include <string>
+
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::cerr << "FAIL: " << what << std::endl;
+        testFailures()++;
+    }
+}
+
+inline int testResult() {
+    std::cout << testFailures() << " failures" << std::endl;
+    return testFailures() == 0 ? 0 : 1;
+}
+
+#endif
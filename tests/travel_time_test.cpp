@@ -0,0 +1,68 @@
+// Checks of travel-time profiles (Graph::travelTime and the time-dependent A*
+// behind aStarSearch) on a hand-built graph: waiting at a CLOSED breakpoint,
+// choosing a detour while an arc is closed, departures that cross midnight, the
+// FIFO property, and the profiles addTravelProfile and setArcProfile refuse.
+
+#include "pathfinder_internal.h"
+#include "test_util.h"
+
+#include <string>
+#include <vector>
+
+const int HOUR = 3600;
+
+int main() {
+    // 0 -> 1 directly (600 s, closed until 11:00), or over 2 (2000 s each way);
+    // 1 -> 3 closes at night
+    Graph graph(4);
+    graph.addArc(0, 1, 600);
+    graph.addArc(0, 2, 2000);
+    graph.addArc(2, 1, 2000);
+    graph.addArc(1, 3, 60);
+    graph.addArc(2, 3, 600);
+    graph.finalize();
+    int closedUntilEleven = graph.addTravelProfile({{0, TravelBreakpoint::CLOSED}, {11 * 60, 100}});
+    int closedAtNight = graph.addTravelProfile({{0, 100}, {23 * 60 + 30, TravelBreakpoint::CLOSED}});
+    int rushHour = graph.addTravelProfile({{0, 100}, {8 * 60, 100}, {9 * 60, 300}, {10 * 60, 100}});
+    check(closedUntilEleven > 0 && closedAtNight > 0 && rushHour > 0, "profiles accepted");
+    check(graph.setArcProfile(0, 1, closedUntilEleven), "profile on 0 -> 1");
+    check(graph.setArcProfile(1, 3, closedAtNight), "profile on 1 -> 3");
+
+    // Closed: wait for the opening, then pay the weight
+    check(graph.travelTime(600, closedUntilEleven, 10 * HOUR) == HOUR + 600, "wait an hour at 10:00");
+    check(graph.travelTime(600, closedUntilEleven, 11 * HOUR) == 600, "open at 11:00");
+    std::vector<int> parent;
+    check(aStarSearch(graph, 0, 1, parent, 9 * HOUR) == 4000 && parent[1] == 2, "detour while closed");
+    check(aStarSearch(graph, 0, 1, parent, 10 * HOUR + 55 * 60) == 900 && parent[1] == 0, "wait when it pays");
+
+    // Around midnight: closed from 23:30 until the profile wraps to minute 0
+    check(graph.travelTime(60, closedAtNight, 23 * HOUR + 50 * 60) == 600 + 60, "wait until midnight");
+    check(graph.travelTime(60, closedAtNight, 24 * HOUR + HOUR) == 60, "time past midnight wraps");
+    check(aStarSearch(graph, 1, 3, parent, 23 * HOUR + 50 * 60) == 660, "route across midnight");
+
+    // Rush hour ramps 100% -> 300% -> 100%, interpolated linearly
+    check(graph.travelTime(600, rushHour, 8 * HOUR + 30 * 60) == 1200, "halfway up the ramp");
+    check(graph.travelTime(600, rushHour, 9 * HOUR) == 1800, "peak");
+
+    // FIFO: leaving later never arrives earlier, over two days
+    for (int profile : {closedUntilEleven, closedAtNight, rushHour}) {
+        int violations = 0;
+        for (int t = 1; t < 2 * SECONDS_PER_DAY; ++t) {
+            if (t + graph.travelTime(600, profile, t) < t - 1 + graph.travelTime(600, profile, t - 1))
+                violations++;
+        }
+        check(violations == 0, "FIFO on profile " + std::to_string(profile));
+    }
+
+    // Rush hour falls by 200% in an hour: fine for 600 s, too steep for 2000 s
+    check(graph.setArcProfile(2, 3, rushHour), "FIFO-safe profile on 2 -> 3");
+    check(!graph.setArcProfile(2, 1, rushHour) && aStarSearch(graph, 2, 1, parent, 9 * HOUR) == 2000,
+          "profile that breaks FIFO refused");
+    check(!graph.setArcProfile(3, 0, rushHour), "profile on a missing arc refused");
+    check(graph.addTravelProfile({{60, 100}}) < 0, "first breakpoint after minute 0");
+    check(graph.addTravelProfile({{0, 100}, {60, 90}}) < 0, "cost below 100%");
+    check(graph.addTravelProfile({{0, 100}, {60, 200}, {30, 100}}) < 0, "breakpoints out of order");
+    check(graph.addTravelProfile({{0, TravelBreakpoint::CLOSED}}) < 0, "never open");
+
+    return testResult();
+}
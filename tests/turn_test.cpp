@@ -0,0 +1,105 @@
+// Checks of the turn model (Graph::enableTurns, addTurnRule, turnAwareSearch) on a
+// hand-built graph where each rule changes the route:
+//
+//     0 --10-- 1 --10-- 2
+//              |\       |
+//              5 3 -30--+
+//
+// with 1 - 5 costing 5 and 1 - 3 costing 30: 5 is a dead end and 1 - 3 - 2 a
+// detour. Forbidding 0 -> 1 -> 2 leaves turning back at 5 (30 plus the U-turn
+// cost) or the detour (70).
+//
+// Turning back is forbidden wherever a node has more than one way on, so hanging
+// 6 off 5 moves the U-turn to 6.
+
+#include "pathfinder_internal.h"
+#include "test_util.h"
+
+#include <climits>
+#include <string>
+#include <vector>
+
+static std::string pathText(const std::vector<int>& path) {
+    std::string text;
+    for (int v : path)
+        text += std::to_string(v) + " ";
+    return text;
+}
+
+// Route from 0 to 2 as its node sequence, and its travel time
+static int route(Graph& graph, std::vector<int>& path) {
+    std::vector<int> parentArc;
+    int lastArc;
+    int distance = turnAwareSearch(graph, 0, 2, 0, parentArc, lastArc);
+    path.clear();
+    if (distance == INT_MAX)
+        return distance;
+    for (int e = lastArc; e != -1; e = parentArc[e])
+        path.insert(path.begin(), graph.head[e]);
+    path.insert(path.begin(), 0);
+    return distance;
+}
+
+static Graph buildGraph(int uTurnCost, bool longSpur) {
+    Graph graph(7);
+    graph.addEdge(0, 1, 10);
+    graph.addEdge(1, 2, 10);
+    graph.addEdge(1, 5, 5);
+    graph.addEdge(1, 3, 30);
+    graph.addEdge(3, 2, 30);
+    if (longSpur)
+        graph.addEdge(5, 6, 1);
+    graph.enableTurns(uTurnCost);
+    return graph;
+}
+
+static void expectRoute(Graph& graph, int distance, const std::vector<int>& path, const std::string& what) {
+    std::vector<int> found;
+    int d = route(graph, found);
+    check(d == distance && found == path, what + ": got " + std::to_string(d) + " via " + pathText(found) +
+          ", expected " + std::to_string(distance) + " via " + pathText(path));
+}
+
+int main() {
+    // No rules: straight through 1
+    Graph free = buildGraph(0, false);
+    expectRoute(free, 20, {0, 1, 2}, "no turn rules");
+
+    // A turn cost is paid, and only wins while it is cheaper than the way round
+    Graph charged = buildGraph(0, false);
+    check(charged.addTurnRule(0, 1, 2, 5), "turn cost 5 rejected");
+    expectRoute(charged, 25, {0, 1, 2}, "turn cost 5");
+    check(charged.addTurnRule(0, 1, 2, 15), "turn cost 15 rejected");
+    expectRoute(charged, 30, {0, 1, 5, 1, 2}, "turn cost 15");
+    check(!charged.addTurnRule(0, 1, 2, -3), "negative turn cost accepted");
+
+    // Forbidden turn: turn back at the dead end 5, paying the U-turn cost
+    Graph forbidden = buildGraph(0, false);
+    forbidden.addTurnRule(0, 1, 2, TURN_FORBIDDEN);
+    expectRoute(forbidden, 30, {0, 1, 5, 1, 2}, "forbidden turn, free U-turn");
+    Graph penalised = buildGraph(8, false);
+    penalised.addTurnRule(0, 1, 2, TURN_FORBIDDEN);
+    expectRoute(penalised, 38, {0, 1, 5, 1, 2}, "forbidden turn, U-turn cost 8");
+
+    // A U-turn dearer than the detour sends the route round by 3
+    Graph detour = buildGraph(100, false);
+    detour.addTurnRule(0, 1, 2, TURN_FORBIDDEN);
+    expectRoute(detour, 70, {0, 1, 3, 2}, "forbidden turn, U-turn cost 100");
+
+    // 5 is no longer a dead end, so the route turns back at 6 instead
+    Graph longSpur = buildGraph(0, true);
+    longSpur.addTurnRule(0, 1, 2, TURN_FORBIDDEN);
+    expectRoute(longSpur, 32, {0, 1, 5, 6, 5, 1, 2}, "U-turn only at the dead end");
+    check(longSpur.turnCost(1, 5, 1) == TURN_FORBIDDEN && longSpur.turnCost(5, 6, 5) == 0,
+          "U-turn rule at 5 and 6");
+
+    // Forbidding the way round as well leaves nothing
+    Graph blocked = buildGraph(100, false);
+    blocked.addTurnRule(0, 1, 2, TURN_FORBIDDEN);
+    blocked.addTurnRule(0, 1, 3, TURN_FORBIDDEN);
+    blocked.addTurnRule(5, 1, 2, TURN_FORBIDDEN);
+    blocked.addTurnRule(5, 1, 3, TURN_FORBIDDEN);
+    std::vector<int> none;
+    check(route(blocked, none) == INT_MAX, "route found through forbidden turns");
+    return testResult();
+}
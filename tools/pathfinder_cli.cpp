@@ -0,0 +1,7 @@
+// Command line front end of the engine library (see pathfinderMain in pathfinder.cpp)
+
+#include "pathfinder.h"
+
+int main(int argc, char* argv[]) {
+    return pathfinderMain(argc, argv);
+}